@@ -0,0 +1,94 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "binpropsimd.h"
+#include <cassert>
+
+//The kernel reads Watched as two 32-bit words, so the extended watch format
+//always uses the scalar loop
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(WATCH_CACHED_LITS)
+#define BINPROP_AVX2
+#include <immintrin.h>
+#endif
+
+using namespace CMSat;
+
+#ifdef BINPROP_AVX2
+static_assert(sizeof(Watched) == 8, "The kernel reads Watched as two 32-bit words");
+#endif
+
+bool BinPropSIMD::available()
+{
+    #ifdef BINPROP_AVX2
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+    #else
+    return false;
+    #endif
+}
+
+#ifdef BINPROP_AVX2
+__attribute__((target("avx2")))
+uint32_t BinPropSIMD::not_true(const Watched* ws, const lbool* assigns)
+{
+    //The implied literal of a binary is the first word of the Watched
+    const __m256i w0 = _mm256_loadu_si256((const __m256i*)ws);
+    const __m256i w1 = _mm256_loadu_si256((const __m256i*)(ws + 4));
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const __m256i lits = _mm256_blend_epi32(
+        _mm256_permutevar8x32_epi32(w0, even)
+        , _mm256_permutevar8x32_epi32(w1, even)
+        , 0xF0
+    );
+    const __m256i vars = _mm256_srli_epi32(lits, 1);
+    const __m256i signs = _mm256_and_si256(lits, _mm256_set1_epi32(1));
+
+    //lbool is one byte. The aligned 32-bit word around it is inside the
+    //allocation because CNF keeps the capacity of 'assigns' padded to 4
+    const __m256i three = _mm256_set1_epi32(3);
+    const __m256i words = _mm256_i32gather_epi32(
+        (const int*)assigns
+        , _mm256_andnot_si256(three, vars)
+        , 1
+    );
+    const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(vars, three), 3);
+    const __m256i vals = _mm256_and_si256(
+        _mm256_srlv_epi32(words, shift)
+        , _mm256_set1_epi32(0xff)
+    );
+
+    //l_True is 0, and flipping it by the sign gives the literal's value
+    const __m256i is_true = _mm256_cmpeq_epi32(
+        _mm256_xor_si256(vals, signs)
+        , _mm256_setzero_si256()
+    );
+    const uint32_t true_mask = _mm256_movemask_ps(_mm256_castsi256_ps(is_true));
+
+    return ~true_mask & 0xff;
+}
+#else
+uint32_t BinPropSIMD::not_true(const Watched*, const lbool*)
+{
+    assert(false);
+    return 0xff;
+}
+#endif
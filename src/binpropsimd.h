@@ -0,0 +1,53 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __BINPROPSIMD_H__
+#define __BINPROPSIMD_H__
+
+#include <cstdint>
+#include "watched.h"
+#include "solvertypes.h"
+
+namespace CMSat {
+
+/**
+@brief Looks up the values of the implied literals of 8 binaries at once
+
+Used on the block of binaries at the front of a watchlist. Only the lanes
+that are not already true need the scalar code, which re-reads their value
+before enqueueing, so the result is the same as that of the scalar loop.
+The kernel is AVX2 only, selected at runtime. Without AVX2 available() is
+false and the scalar loop is used.
+*/
+class BinPropSIMD
+{
+    public:
+        static const size_t lanes = 8;
+        static bool available();
+
+        ///Bit k is set if ws[k].lit2() is not true. All 8 must be binaries.
+        ///The allocation of assigns must be padded to a multiple of 4 values
+        static uint32_t not_true(const Watched* ws, const lbool* assigns);
+};
+
+}
+
+#endif //__BINPROPSIMD_H__
@@ -70,7 +70,7 @@ bool BVA::bounded_var_addition()
     for(size_t i = 0; i < solver->nVars()*2; i++) {
         const Lit lit = Lit::toLit(i);
         if (solver->value(lit) != l_Undef
-            || solver->varData[lit.var()].removed != Removed::none
+            || solver->varDataCold[lit.var()].removed != Removed::none
         ) {
             continue;
         }
@@ -260,7 +260,7 @@ void BVA::remove_duplicates_from_m_cls()
 bool BVA::try_bva_on_lit(const Lit lit)
 {
     assert(solver->value(lit) == l_Undef);
-    assert(solver->varData[lit.var()].removed == Removed::none);
+    assert(solver->varDataCold[lit.var()].removed == Removed::none);
 
     m_cls.clear();
     m_lits.clear();
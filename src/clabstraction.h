@@ -22,6 +22,8 @@
 #ifndef __CL_ABSTRACTION__H__
 #define __CL_ABSTRACTION__H__
 
+#include <cstdint>
+
 typedef uint32_t cl_abst_type;
 static const int cl_abst_modulo = 29;
 
@@ -34,8 +36,9 @@ template <class T>
 cl_abst_type calcAbstraction(const T& ps)
 {
     cl_abst_type abstraction = 0;
+    //Only the low cl_abst_modulo bits are used, Watched relies on this
     if (ps.size() > 50) {
-        return ~((cl_abst_type)(0ULL));
+        return (1UL << cl_abst_modulo) - 1;
     }
 
     for (auto l: ps)
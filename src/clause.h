@@ -80,6 +80,11 @@ struct ResolutionTypes
     T redL = 0;
 };
 
+//Tiers of the redundant clauses, see CNF::update_red_tier()
+static const uint32_t red_local = 0; ///<Cleaned by ReduceDB
+static const uint32_t red_tier2 = 1; ///<Kept while it is used, else moved to red_local
+static const uint32_t red_core = 2; ///<Kept forever
+
 struct ClauseStats
 {
     ClauseStats()
@@ -88,10 +93,14 @@ struct ClauseStats
     }
 
     //Stored data
-    uint32_t glue:29;
+    uint32_t glue:27;
     uint32_t locked:1;
     uint32_t marked_clause:1;
     uint32_t ttl:1;
+    uint32_t imported:1; ///<Received from another thread
+    uint32_t import_used:1; ///<Imported, and used in conflict analysis at least once
+    uint32_t which_red_array:2; ///<Tier of a redundant clause: red_local, red_tier2 or red_core
+    uint32_t used_since_clean:1; ///<Used in conflict analysis since the last cleaning
     double   activity = 0.0;
     #ifdef STATS_NEEDED
     uint64_t introduced_at_conflict = 0; ///<At what conflict number the clause  was introduced
@@ -135,6 +144,10 @@ struct ClauseStats
         ret.used_for_uip_creation = first.used_for_uip_creation + second.used_for_uip_creation;
         #endif
         ret.locked = first.locked | second.locked;
+        ret.which_red_array = std::max(first.which_red_array, second.which_red_array);
+        ret.used_since_clean = first.used_since_clean | second.used_since_clean;
+        ret.imported = first.imported | second.imported;
+        ret.import_used = first.import_used | second.import_used;
 
         return ret;
     }
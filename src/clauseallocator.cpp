@@ -30,8 +30,14 @@
 #include "searcher.h"
 #include "time_mem.h"
 #include "occsimplifier.h"
-#include "completedetachreattacher.h"
 #include "sqlstats.h"
+#include "hugepages.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #ifdef USE_VALGRIND
 #include "valgrind/valgrind.h"
@@ -51,19 +57,25 @@ using std::endl;
 //For listing each and every clause location:
 //#define DEBUG_CLAUSEALLOCATOR2
 
-#define MIN_LIST_SIZE (50000 * (sizeof(Clause) + 4*sizeof(Lit))/sizeof(uint32_t))
 #define ALLOC_GROW_MULT 2
-//We shift stuff around in Watched, so not all of 32 bits are useable.
-#define EFFECTIVELY_USEABLE_BITS 30
-#define MAXSIZE ((1 << (EFFECTIVELY_USEABLE_BITS))-1)
+//All 32 bits of ClOffset are useable. CL_OFFSET_MAX itself is never an offset
+#define MAXSIZE ((size_t)CL_OFFSET_MAX)
+#define NO_SLAB std::numeric_limits<size_t>::max()
 
 ClauseAllocator::ClauseAllocator() :
     dataStart(NULL)
-    , size(0)
     , maxSize(0)
+    , num_cls(0)
     , currentlyUsedSize(0)
+    , reserved_start(NULL)
+    , reserved_bytes(0)
+    , reserved(false)
+    , mapped(false)
+    , huge_pages(false)
 {
-    assert(MIN_LIST_SIZE < MAXSIZE);
+    assert((MAXSIZE >> slab_bits) < std::numeric_limits<uint32_t>::max());
+    cur_slab[0] = NO_SLAB;
+    cur_slab[1] = NO_SLAB;
 }
 
 /**
@@ -71,7 +83,20 @@ ClauseAllocator::ClauseAllocator() :
 */
 ClauseAllocator::~ClauseAllocator()
 {
+    free_memory();
+}
+
+void ClauseAllocator::free_memory()
+{
+    #if defined(__linux__)
+    if (reserved) {
+        munmap(reserved_start, reserved_bytes);
+        dataStart = NULL;
+        return;
+    }
+    #endif
     free(dataStart);
+    dataStart = NULL;
 }
 
 /**
@@ -81,9 +106,10 @@ template<class T>
 Clause* ClauseAllocator::Clause_new(
     const T& ps
     , const uint32_t conflictNum
+    , const bool red
 )
 {
-    void* mem = allocEnough(ps.size());
+    void* mem = allocEnough(ps.size(), red);
     Clause* real= new (mem) Clause(ps, conflictNum);
 
     return real;
@@ -92,45 +118,123 @@ Clause* ClauseAllocator::Clause_new(
 template Clause* ClauseAllocator::Clause_new(
     const vector<Lit>& ps
     , uint32_t conflictNum
+    , const bool red
 );
 
 /**
 @brief Allocates space for a new clause & copies a give clause to it
 */
-Clause* ClauseAllocator::Clause_new(Clause& c)
+Clause* ClauseAllocator::Clause_new(const Clause& c)
 {
     assert(c.size() > 3);
-    void* mem = allocEnough(c.size());
+    void* mem = allocEnough(c.size(), c.red());
     memcpy(mem, &c, sizeof(Clause)+sizeof(Lit)*c.size());
 
     return (Clause*)mem;
 }
 
-void* ClauseAllocator::allocEnough(
-    uint32_t clauseSize
-) {
-    //Try to quickly find a place at the end of a dataStart
-    uint32_t neededbytes = (sizeof(Clause) + sizeof(Lit)*clauseSize);
-    uint32_t needed
-        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+/**
+@brief Maps the address space of the first 'elems' datapieces
+
+Only address space is taken, memory is used once it is written to. The mapping
+is grown with grow_reserved() as slabs are needed, so the clauses are never
+copied. If this fails, the slabs are allocated with realloc, as they are
+needed.
+*/
+void ClauseAllocator::reserve(const size_t elems)
+{
+    const size_t bytes = elems*sizeof(BASE_DATA_TYPE);
+    void* mem = HugePages::map(bytes, false, true);
+    if (mem == NULL) {
+        std::cerr
+        << "c WARNING: could not map " << bytes/(1024UL*1024UL)
+        << " MB for the clauses, using realloc. Growing will copy them"
+        << endl;
+        return;
+    }
+
+    //Aligned to huge pages, so that the slabs can be backed by them
+    reserved_start = mem;
+    reserved_bytes = bytes;
+    reserved = true;
+    dataStart = (BASE_DATA_TYPE*)mem;
+    maxSize = elems;
+}
+
+/**
+@brief Grows the mapping to hold at least 'elems' datapieces
+
+The pages are moved by mremap(), not copied, but dataStart may change. Returns
+false if the mapping could not be grown.
+*/
+bool ClauseAllocator::grow_reserved(const size_t elems)
+{
+    #if defined(__linux__)
+    assert(reserved);
+    size_t new_size = std::max<size_t>(maxSize * ALLOC_GROW_MULT, elems);
+    new_size = std::min<size_t>(new_size, MAXSIZE + 1);
+    const size_t new_bytes = new_size*sizeof(BASE_DATA_TYPE);
+    void* mem = mremap(reserved_start, reserved_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
 
-    if (size + needed > maxSize) {
-        //Grow by default, but don't go under or over the limits
-        size_t newMaxSize = maxSize * ALLOC_GROW_MULT;
-        newMaxSize = std::min<size_t>(newMaxSize, MAXSIZE);
-        newMaxSize = std::max<size_t>(newMaxSize, MIN_LIST_SIZE);
+    reserved_start = mem;
+    reserved_bytes = new_bytes;
+    dataStart = (BASE_DATA_TYPE*)mem;
+    maxSize = new_size;
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+/**
+@brief Makes cur_slab[red] a slab with at least 'needed' free space at its end
+
+A clause larger than a slab gets a run of new, consecutive slabs. The first one
+of the run holds the clause alone, its size covers the whole run, and the rest
+stay empty. They are never used for other clauses.
+*/
+void ClauseAllocator::new_slab(const size_t needed, const bool red)
+{
+    const size_t run = std::max<size_t>(1, (needed + slab_size - 1) >> slab_bits);
+    vector<uint32_t>& reusable = reusable_slabs[red];
+    if (run == 1
+        && !reusable.empty()
+        && slabs[reusable.back()].size + needed <= slab_size
+    ) {
+        cur_slab[red] = reusable.back();
+        reusable.pop_back();
+        return;
+    }
 
-        //Oops, not enough space anyway
-        if (newMaxSize < size + needed) {
+    if (dataStart == NULL) {
+        reserve((slabs.size() + run) << slab_bits);
+    }
+
+    const size_t newSlabs = slabs.size() + run;
+    if ((newSlabs << slab_bits) - 1 > MAXSIZE) {
+        std::cerr
+        << "ERROR: memory manager can't handle the load"
+        << " slabs: " << slabs.size()
+        << endl;
+
+        throw std::bad_alloc();
+    }
+
+    if ((newSlabs << slab_bits) > maxSize && reserved) {
+        if (!grow_reserved(newSlabs << slab_bits)) {
             std::cerr
-            << "ERROR: memory manager can't handle the load"
-            << " size: " << size
-            << " needed: " << needed
-            << " newMaxSize: " << newMaxSize
+            << "ERROR: while growing the mapping of the clauses"
             << endl;
 
             throw std::bad_alloc();
         }
+    } else if ((newSlabs << slab_bits) > maxSize) {
+        //Grow by default, but don't go over the limit
+        size_t newMaxSize = std::max<size_t>(maxSize * ALLOC_GROW_MULT, newSlabs << slab_bits);
+        newMaxSize = std::min<size_t>(newMaxSize, MAXSIZE + 1);
 
         //Reallocate data
         dataStart = (BASE_DATA_TYPE*)realloc(
@@ -151,11 +255,41 @@ void* ClauseAllocator::allocEnough(
         maxSize = newMaxSize;
     }
 
+    if (reserved && huge_pages) {
+        HugePages::advise(dataStart + (slabs.size() << slab_bits)
+            , (run << slab_bits)*sizeof(BASE_DATA_TYPE));
+    }
+
+    cur_slab[red] = slabs.size();
+    for(size_t i = 0; i < run; i++) {
+        slabs.push_back(Slab());
+        slabs.back().nursery = red;
+    }
+}
+
+void* ClauseAllocator::allocEnough(
+    uint32_t clauseSize
+    , const bool red
+) {
+    //Try to quickly find a place at the end of the current slab
+    const size_t neededbytes = (sizeof(Clause) + sizeof(Lit)*(size_t)clauseSize);
+    const size_t needed
+        = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+
+    //Clauses larger than a slab get slabs of their own
+    if (cur_slab[red] == NO_SLAB || slabs[cur_slab[red]].size + needed > slab_size) {
+        new_slab(needed, red);
+    }
+
     //Add clause to the set
-    Clause* pointer = (Clause*)(dataStart + size);
-    size += needed;
+    const size_t at = cur_slab[red];
+    Slab& slab = slabs[at];
+    Clause* pointer = (Clause*)(dataStart + (at << slab_bits) + slab.size);
+    slab.size += needed;
+    slab.currentlyUsedSize += needed;
+    slab.origClauseSizes.push_back(needed);
     currentlyUsedSize += needed;
-    origClauseSizes.push_back(needed);
+    num_cls++;
 
     return pointer;
 }
@@ -191,7 +325,9 @@ void ClauseAllocator::clauseFree(Clause* cl)
     cl->setFreed();
     size_t bytes_freed = (sizeof(Clause) + cl->size()*sizeof(Lit));
     size_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
+    slabs[get_offset(cl) >> slab_bits].currentlyUsedSize -= elems_freed;
     currentlyUsedSize -= elems_freed;
+    num_cls--;
 
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
     VALGRIND_MAKE_MEM_UNDEFINED(((char*)cl)+sizeof(Clause), cl->size()*sizeof(Lit));
@@ -205,45 +341,45 @@ void ClauseAllocator::clauseFree(ClOffset offset)
 }
 
 /**
-@brief If needed, compacts stacks, removing unused clauses
+@brief Gives the memory of the datapieces [from, to) back to the OS
 
-Firstly, the algorithm determines if the number of useless slots is large or
-small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+Pages of a shared mapping that were not copied yet are not freed, and read as
+the clauses that were shared, not zeroes. They are only read after new clauses
+are written over them.
 */
-void ClauseAllocator::consolidate(
-    Solver* solver
-    , const bool force
-) {
-    const double myTime = cpuTime();
-
-    //If re-allocation is not really neccessary, don't do it
-    //Neccesities:
-    //1) There is too much memory allocated. Re-allocation will save space
-    //   Avoiding segfault (max is 16 outerOffsets, more than 10 is near)
-    //2) There is too much empty, unused space (>30%)
-    if (!force
-        && ((double)currentlyUsedSize/(double)size > 0.7)
-    ) {
-        if (solver->conf.verbosity >= 3) {
-            cout << "c Not consolidating memory." << endl;
-        }
+void ClauseAllocator::release_unused(const size_t from, const size_t to)
+{
+    if (!reserved) {
         return;
     }
 
-    //Data for new struct
+    HugePages::release(dataStart + from, (to - from)*sizeof(BASE_DATA_TYPE));
+}
+
+/**
+@brief Moves the non-freed clauses of a slab to its start
+
+The old and new offsets of the clauses that moved are appended to
+moved_from and moved_to, in increasing order. Returns true if the slab can be
+used for new clauses again.
+*/
+bool ClauseAllocator::compact_slab(
+    const size_t at
+    , vector<ClOffset>& moved_from
+    , vector<ClOffset>& moved_to
+) {
+    Slab& slab = slabs[at];
+    const size_t slab_start = at << slab_bits;
     vector<uint32_t> newOrigClauseSizes;
-    vector<ClOffset> newOffsets;
-    uint64_t newSize = 0;
+    size_t newSize = 0;
 
     //Pointers that will be moved along
-    BASE_DATA_TYPE* newDataStart = dataStart;
-    BASE_DATA_TYPE* tmpDataStart = dataStart;
+    BASE_DATA_TYPE* newDataStart = dataStart + slab_start;
+    BASE_DATA_TYPE* tmpDataStart = dataStart + slab_start;
 
-    assert(sizeof(Clause) % sizeof(BASE_DATA_TYPE) == 0);
+    assert(sizeof(Clause) % sizeof(Lit) == 0);
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
-    for (const size_t sz: origClauseSizes) {
+    for (const size_t sz: slab.origClauseSizes) {
         Clause* clause = (Clause*)tmpDataStart;
         //Already freed, so skip entirely
         if (clause->freed()) {
@@ -258,10 +394,13 @@ void ClauseAllocator::consolidate(
         size_t bytesNeeded = sizeof(Clause) + clause->size()*sizeof(Lit);
         size_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
         assert(sizeNeeded <= sz && "New clause size must not be bigger than orig clause size");
-        memmove(newDataStart, tmpDataStart, sizeNeeded*sizeof(BASE_DATA_TYPE));
 
-        //Record position
-        newOffsets.push_back(newSize);
+        //Clauses that stay in place are not written, so shared pages stay shared
+        if (newDataStart != tmpDataStart) {
+            memmove(newDataStart, tmpDataStart, sizeNeeded*sizeof(BASE_DATA_TYPE));
+            moved_from.push_back(tmpDataStart - dataStart);
+            moved_to.push_back(newDataStart - dataStart);
+        }
 
         //Record sizes
         newOrigClauseSizes.push_back(sizeNeeded);
@@ -271,39 +410,132 @@ void ClauseAllocator::consolidate(
         newDataStart += sizeNeeded;
         tmpDataStart += sz;
     }
+    release_unused(slab_start + newSize, slab_start + slab.size);
+
+    //Update sizes
+    currentlyUsedSize -= slab.currentlyUsedSize;
+    currentlyUsedSize += newSize;
+    slab.size = newSize;
+    slab.currentlyUsedSize = newSize;
+    newOrigClauseSizes.swap(slab.origClauseSizes);
+
+    return at != cur_slab[slab.nursery] && newSize <= slab_size/2;
+}
+
+/**
+@brief If needed, compacts slabs, removing unused clauses
+
+Firstly, the algorithm determines for each slab if the number of useless
+slots is large or small compared to its size. The slabs with many of them are
+compacted in place, and the offsets of the clauses that moved are updated.
+The other slabs are not touched.
+*/
+void ClauseAllocator::consolidate(
+    Solver* solver
+    , const bool force
+) {
+    compact(solver, force, false);
+}
+
+/**
+@brief Compacts only the nursery slabs, where the redundant clauses are
+
+Used after cleaning the clause database. Only the watchlists of the moved
+clauses' watched literals and the list of redundant clauses are updated, so the
+time taken does not depend on the number of irredundant clauses.
+*/
+void ClauseAllocator::consolidate_nursery(Solver* solver)
+{
+    compact(solver, false, true);
+}
+
+void ClauseAllocator::compact(
+    Solver* solver
+    , const bool force
+    , const bool nursery_only
+) {
+    const double myTime = cpuTime();
+
+    //If re-allocation is not really neccessary, don't do it
+    //Neccesities:
+    //1) There is too much memory allocated. Re-allocation will save space
+    //2) There is too much empty, unused space (>30%)
+    vector<char> slab_compacted(slabs.size(), 0);
+    size_t num_compacted = 0;
+    for(size_t at = 0; at < slabs.size(); at++) {
+        const Slab& slab = slabs[at];
+        if ((nursery_only && !slab.nursery)
+            || slab.currentlyUsedSize == slab.size
+            || (!force && (double)slab.currentlyUsedSize/(double)slab.size > 0.7)
+        ) {
+            continue;
+        }
+        slab_compacted[at] = 1;
+        num_compacted++;
+    }
+    if (num_compacted == 0) {
+        if (solver->conf.verbosity >= 3) {
+            cout << "c Not consolidating memory." << endl;
+        }
+        return;
+    }
+
+    size_t old_size = 0;
+    for(const Slab& slab: slabs) {
+        old_size += slab.size;
+    }
+    vector<ClOffset> moved_from;
+    vector<ClOffset> moved_to;
+    for(size_t at = 0; at < slabs.size(); at++) {
+        if (!slab_compacted[at]) {
+            continue;
+        }
+        const bool reusable = compact_slab(at, moved_from, moved_to);
+        vector<uint32_t>& reusable_gen = reusable_slabs[slabs[at].nursery];
+        if (reusable
+            && std::find(reusable_gen.begin(), reusable_gen.end(), at) == reusable_gen.end()
+        ) {
+            reusable_gen.push_back(at);
+        }
+    }
 
     //Update offsets & pointers(?) now, when everything is in memory still
-    updateAllOffsetsAndPointers(solver, newOffsets);
+    if (nursery_only) {
+        update_moved_watches(solver, moved_from, moved_to);
+    } else {
+        updateAllOffsetsAndPointers(solver, moved_from, moved_to, slab_compacted);
+    }
+    size_t new_size = 0;
+    for(const Slab& slab: slabs) {
+        new_size += slab.size;
+    }
 
     const double time_used = cpuTime() - myTime;
     if (solver->conf.verbosity >= 2) {
-        cout << "c [mem] Consolidated memory ";
-        cout << " cls"; print_value_kilo_mega(newOrigClauseSizes.size());
-        cout << " old size"; print_value_kilo_mega(size);
-        cout << " new size"; print_value_kilo_mega(newSize);
+        cout << "c [mem] Consolidated " << (nursery_only ? "nursery" : "memory") << " ";
+        cout << " slabs " << num_compacted << "/" << slabs.size();
+        cout << " moved cls"; print_value_kilo_mega(moved_from.size());
+        cout << " old size"; print_value_kilo_mega(old_size);
+        cout << " new size"; print_value_kilo_mega(new_size);
         cout << solver->conf.print_times(time_used)
         << endl;
     }
     if (solver->sqlStats) {
         solver->sqlStats->time_passed_min(
             solver
-            , "consolidate"
+            , nursery_only ? "consolidate nursery" : "consolidate"
             , time_used
         );
     }
-
-    //Update sizes
-    size = newSize;
-    currentlyUsedSize = newSize;
-    newOrigClauseSizes.swap(origClauseSizes);
 }
 
 void ClauseAllocator::updateAllOffsetsAndPointers(
     Solver* solver
-    , const vector<ClOffset>& offsets
+    , const vector<ClOffset>& moved_from
+    , const vector<ClOffset>& moved_to
+    , const vector<char>& slab_compacted
 ) {
     //Must be at toplevel, otherwise propBy reset will not work
-    //and also, detachReattacher will fail
     assert(solver->decisionLevel() == 0);
 
     //We are at decision level 0, so we can reset all PropBy-s
@@ -311,14 +543,10 @@ void ClauseAllocator::updateAllOffsetsAndPointers(
         vdata.reason = PropBy();
     }
 
-    //Detach long clauses
-    CompleteDetachReatacher detachReattach(solver);
-    detachReattach.detach_nonbins_nontris();
-
     //Make sure all non-freed clauses were accessible from solver
     const size_t origNumClauses =
         solver->longIrredCls.size() + solver->longRedCls.size();
-    if (origNumClauses != offsets.size()) {
+    if (origNumClauses != num_cls) {
         std::cerr
         << "ERROR: Not all non-freed clauses are accessible from Solver"
         << endl
@@ -326,39 +554,262 @@ void ClauseAllocator::updateAllOffsetsAndPointers(
         << endl
         << " no. clauses accessible from solver: " << origNumClauses
         << endl
-        << " no. clauses non-freed: " << offsets.size()
+        << " no. clauses non-freed: " << num_cls
         << endl;
 
-        assert(origNumClauses == offsets.size());
+        assert(origNumClauses == num_cls);
         std::exit(-1);
     }
 
-    //Clear clauses
-    solver->longIrredCls.clear();
-    solver->longRedCls.clear();
+    //moved_from is sorted, so the new offset is found by binary search
+    auto new_offset = [&](const ClOffset offset) -> ClOffset {
+        if (!slab_compacted[offset >> slab_bits]) {
+            return offset;
+        }
+        const auto it = std::lower_bound(moved_from.begin(), moved_from.end(), offset);
+        if (it == moved_from.end() || *it != offset) {
+            return offset;
+        }
+        return moved_to[it - moved_from.begin()];
+    };
 
-    //Add back to the solver the correct red & irred clauses
-    for(auto offset: offsets) {
-        Clause* cl = ptr(offset);
-        assert(!cl->freed());
+    for(ClOffset& offset: solver->longIrredCls) {
+        offset = new_offset(offset);
+    }
+    for(ClOffset& offset: solver->longRedCls) {
+        offset = new_offset(offset);
+    }
+    for(watch_array::iterator
+        it = solver->watches.begin(), end = solver->watches.end()
+        ; it != end
+        ; ++it
+    ) {
+        for(Watched& w: *it) {
+            if (w.isClause()) {
+                w.setNormOffset(new_offset(w.get_offset()));
+            }
+        }
+    }
+}
 
-        //Put it in the right bucket
-        if (cl->red()) {
-            solver->longRedCls.push_back(offset);
-        } else {
-            solver->longIrredCls.push_back(offset);
+/**
+@brief Updates the offsets of the moved clauses, looking only where they can be
+
+A long clause is only referenced from the lists of long clauses, and the
+watchlists of its first two literals. The clauses have been moved already, so
+their literals are read from their new place.
+*/
+void ClauseAllocator::update_moved_watches(
+    Solver* solver
+    , const vector<ClOffset>& moved_from
+    , const vector<ClOffset>& moved_to
+) {
+    assert(solver->decisionLevel() == 0);
+    if (moved_from.empty()) {
+        return;
+    }
+
+    //We are at decision level 0, so we can reset all PropBy-s
+    for (auto& vdata: solver->varData) {
+        vdata.reason = PropBy();
+    }
+
+    //moved_from is sorted, so the new offset is found by binary search
+    auto new_offset = [&](const ClOffset offset) -> ClOffset {
+        const auto it = std::lower_bound(moved_from.begin(), moved_from.end(), offset);
+        if (it == moved_from.end() || *it != offset) {
+            return offset;
+        }
+        return moved_to[it - moved_from.begin()];
+    };
+
+    //Each watchlist must only be updated once, as a new offset can be
+    //the old offset of another moved clause
+    vector<uint32_t> lits;
+    bool moved_irred = false;
+    for(const ClOffset offset: moved_to) {
+        const Clause& cl = *ptr(offset);
+        lits.push_back(cl[0].toInt());
+        lits.push_back(cl[1].toInt());
+        moved_irred |= !cl.red();
+    }
+    std::sort(lits.begin(), lits.end());
+    lits.erase(std::unique(lits.begin(), lits.end()), lits.end());
+
+    for(const uint32_t lit: lits) {
+        for(Watched& w: solver->watches[lit]) {
+            if (w.isClause()) {
+                w.setNormOffset(new_offset(w.get_offset()));
+            }
         }
     }
+    for(ClOffset& offset: solver->longRedCls) {
+        offset = new_offset(offset);
+    }
 
-    //Finally, reattach long clauses
-    detachReattach.reattachLongs();
+    //Clauses that became irredundant stay where they were allocated
+    if (moved_irred) {
+        for(ClOffset& offset: solver->longIrredCls) {
+            offset = new_offset(offset);
+        }
+    }
+}
+
+void ClauseAllocator::count_pages(HugePages::PageStats& stats) const
+{
+    HugePages::count_pages(dataStart, get_data_size(), stats);
 }
 
 size_t ClauseAllocator::mem_used() const
 {
     uint64_t mem = 0;
-    mem += maxSize*sizeof(BASE_DATA_TYPE);
-    mem += origClauseSizes.capacity()*sizeof(uint32_t);
+    if (reserved) {
+        //Only the used parts of the slabs are backed by memory
+        for(const Slab& slab: slabs) {
+            mem += slab.size*sizeof(BASE_DATA_TYPE);
+        }
+    } else {
+        mem += maxSize*sizeof(BASE_DATA_TYPE);
+    }
+    for(const Slab& slab: slabs) {
+        mem += slab.origClauseSizes.capacity()*sizeof(uint32_t);
+    }
+    mem += slabs.capacity()*sizeof(Slab);
 
     return mem;
 }
+
+/**
+@brief Makes the empty allocators share the clauses of the first one
+
+The memory of all of them is replaced by private mappings of the same memory
+file that holds the clauses, so the clauses are at the same offsets in all of
+them. A page is only copied once an allocator writes to it: when it moves
+watches inside a clause, strengthens it, frees it, or allocates a new clause.
+Propagation moves the watches of the clauses it visits, so during search most
+pages are copied soon, and the memory is mostly saved while simplifying.
+
+The mappings have room for the shared slabs and as many new ones. Beyond
+that they are grown like any other mapping, the memory file is large enough
+for that. Returns false if nothing was shared.
+*/
+bool ClauseAllocator::share_copy_on_write(const vector<ClauseAllocator*>& allocs)
+{
+    #if defined(__linux__)
+    const ClauseAllocator& orig = *allocs[0];
+    if (orig.slabs.empty() || orig.mapped) {
+        return false;
+    }
+    for(size_t i = 1; i < allocs.size(); i++) {
+        if (allocs[i]->mapped || !allocs[i]->slabs.empty()) {
+            return false;
+        }
+    }
+
+    const size_t elems = std::min<size_t>(
+        (orig.slabs.size() << slab_bits)*ALLOC_GROW_MULT, MAXSIZE + 1);
+    const size_t bytes = elems*sizeof(BASE_DATA_TYPE);
+    const int fd = memfd_create("cmsat-clauses", 0);
+    if (fd == -1) {
+        return false;
+    }
+    bool ok = (ftruncate(fd, (MAXSIZE + 1)*sizeof(BASE_DATA_TYPE)) == 0);
+    for(size_t at = 0; ok && at < orig.slabs.size(); at++) {
+        const size_t slab_start = (at << slab_bits)*sizeof(BASE_DATA_TYPE);
+        const char* buf = (const char*)orig.dataStart + slab_start;
+        const size_t to_write = orig.slabs[at].size*sizeof(BASE_DATA_TYPE);
+        size_t written = 0;
+        while(ok && written < to_write) {
+            const ssize_t ret = pwrite(fd, buf + written, to_write - written, slab_start + written);
+            ok = (ret > 0);
+            if (ok) {
+                written += ret;
+            }
+        }
+    }
+
+    vector<void*> mems;
+    for(size_t i = 0; ok && i < allocs.size(); i++) {
+        void* mem = mmap(NULL, bytes, PROT_READ | PROT_WRITE
+            , MAP_PRIVATE | MAP_NORESERVE, fd, 0);
+        if (mem == MAP_FAILED) {
+            ok = false;
+        } else {
+            mems.push_back(mem);
+        }
+    }
+    close(fd);
+    if (!ok) {
+        for(void* mem: mems) {
+            munmap(mem, bytes);
+        }
+        return false;
+    }
+
+    for(size_t i = 0; i < allocs.size(); i++) {
+        ClauseAllocator& alloc = *allocs[i];
+        alloc.free_memory();
+        alloc.dataStart = (BASE_DATA_TYPE*)mems[i];
+        alloc.reserved_start = mems[i];
+        alloc.reserved_bytes = bytes;
+        alloc.maxSize = elems;
+        alloc.reserved = true;
+        alloc.mapped = true;
+        if (i > 0) {
+            alloc.slabs = orig.slabs;
+            for(size_t red = 0; red < 2; red++) {
+                alloc.cur_slab[red] = orig.cur_slab[red];
+                alloc.reusable_slabs[red] = orig.reusable_slabs[red];
+            }
+            alloc.num_cls = orig.num_cls;
+            alloc.currentlyUsedSize = orig.currentlyUsedSize;
+        }
+    }
+
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+/**
+@brief Memory of the used part that is still shared with the other allocators
+
+Pages that have been copied on write are anonymous, the ones still shared
+are backed by the memory file. Pages never touched are not counted.
+*/
+size_t ClauseAllocator::mem_shared() const
+{
+    size_t shared = 0;
+    #if defined(__linux__)
+    if (!mapped) {
+        return 0;
+    }
+
+    const int fd = open("/proc/self/pagemap", O_RDONLY);
+    if (fd == -1) {
+        return 0;
+    }
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t first_page = (size_t)dataStart / page_size;
+    const size_t num_pages = (get_data_size() + page_size - 1) / page_size;
+    vector<uint64_t> entries(1024);
+    for(size_t at = 0; at < num_pages; at += entries.size()) {
+        const size_t num = std::min<size_t>(entries.size(), num_pages - at);
+        const ssize_t ret = pread(fd, entries.data(), num*sizeof(uint64_t)
+            , (first_page + at)*sizeof(uint64_t));
+        if (ret != (ssize_t)(num*sizeof(uint64_t))) {
+            break;
+        }
+        for(size_t i = 0; i < num; i++) {
+            //Bit 63: present, bit 61: file page or shared anonymous
+            if (((entries[i] >> 63) & 1) && ((entries[i] >> 61) & 1)) {
+                shared += page_size;
+            }
+        }
+    }
+    close(fd);
+    #endif
+
+    return shared;
+}
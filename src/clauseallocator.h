@@ -30,11 +30,17 @@
 #include <vector>
 
 #include "watched.h"
-
-#define BASE_DATA_TYPE uint64_t
+#include "hugepages.h"
 
 namespace CMSat {
 
+///Unit of ClOffset. With 32-bit offsets, the clauses can take up to 64GB
+struct ClauseSlot
+{
+    uint64_t data[2];
+};
+#define BASE_DATA_TYPE ClauseSlot
+
 class Clause;
 class Solver;
 class PropEngine;
@@ -50,6 +56,18 @@ needed. When instructed, it consolidates the unused space (i.e. clauses free()-e
 Essentially, it is a stack-like allocator for clauses. It is useful to have
 this, because this way, we can address clauses according to their number,
 which is 32-bit, instead of their address, which might be 64-bit
+
+The memory is made up of fixed-size slabs, and the top bits of an offset are
+the slab's index. Where possible, the slabs are in an mmap-ed mapping that is
+grown with mremap, so growing moves pages instead of copying clauses. A
+clause larger than a slab gets a run of consecutive slabs of its own.
+Consolidation only compacts the slabs with enough freed clauses in them, and
+gives the memory freed at their ends back to the OS.
+
+Slabs belong to one of two generations. Redundant clauses are allocated in
+nursery slabs, everything else in old slabs. Most of the clauses freed during
+search are learnt ones, so after a database cleaning only the nursery is
+compacted, and only the watchlists of the moved clauses are updated.
 */
 class ClauseAllocator {
     public:
@@ -59,8 +77,9 @@ class ClauseAllocator {
         template<class T> Clause* Clause_new(
             const T& ps
             , uint32_t conflictNum
+            , const bool red = false
         );
-        Clause* Clause_new(Clause& c);
+        Clause* Clause_new(const Clause& c);
 
         ClOffset get_offset(const Clause* ptr) const;
 
@@ -83,35 +102,93 @@ class ClauseAllocator {
             Solver* solver
             , const bool force = false
         );
+        void consolidate_nursery(Solver* solver);
 
         size_t mem_used() const;
+        void set_huge_pages(const bool huge)
+        {
+            huge_pages = huge;
+        }
+
+        static bool share_copy_on_write(const vector<ClauseAllocator*>& allocs);
+        bool is_shared() const
+        {
+            return mapped;
+        }
+        size_t mem_shared() const;
+        void count_pages(HugePages::PageStats& stats) const;
+
+        //Where the clauses are in memory
+        const void* get_data_start() const
+        {
+            return dataStart;
+        }
+        size_t get_data_size() const
+        {
+            return (slabs.size() << slab_bits)*sizeof(BASE_DATA_TYPE);
+        }
 
     private:
+        ///Offsets are (slab index << slab_bits) | position in slab
+        static const size_t slab_bits = 20;
+        static const size_t slab_size = 1UL << slab_bits;
+
+        struct Slab
+        {
+            size_t size = 0; ///<The number of BASE_DATA_TYPE datapieces used, from the start
+            /**
+            @brief The estimated used size of the slab
+            This is incremented by clauseSize each time a clause is allocated, and
+            decremetented by clauseSize each time a clause is deallocated. The
+            problem is, that clauses can shrink, and thus this value will be an
+            overestimation almost all the time
+            */
+            size_t currentlyUsedSize = 0;
+            /**
+            @brief Clauses in the slab had this size when they were allocated
+            This my NOT be their current size: the clauses may be shrinked during
+            the running of the solver. Therefore, it is imperative that their orignal
+            size is saved. This way, we can later move clauses around.
+            */
+            vector<uint32_t> origClauseSizes;
+            bool nursery = false; ///<Holds redundant clauses
+        };
+
+        void compact(Solver* solver, const bool force, const bool nursery_only);
+        bool compact_slab(const size_t at, vector<ClOffset>& moved_from, vector<ClOffset>& moved_to);
+        void release_unused(const size_t from, const size_t to);
         void updateAllOffsetsAndPointers(
             Solver* solver
-            , const vector<ClOffset>& offsets
+            , const vector<ClOffset>& moved_from
+            , const vector<ClOffset>& moved_to
+            , const vector<char>& slab_compacted
         );
-
-        BASE_DATA_TYPE* dataStart; ///<Stacks start at these positions
-        size_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
-        /**
-        @brief Clauses in the stack had this size when they were allocated
-        This my NOT be their current size: the clauses may be shrinked during
-        the running of the solver. Therefore, it is imperative that their orignal
-        size is saved. This way, we can later move clauses around.
-        */
-        vector<uint32_t> origClauseSizes;
-        size_t maxSize; ///<The number of BASE_DATA_TYPE datapieces allocated
-        /**
-        @brief The estimated used size of the stack
-        This is incremented by clauseSize each time a clause is allocated, and
-        decremetented by clauseSize each time a clause is deallocated. The
-        problem is, that clauses can shrink, and thus this value will be an
-        overestimation almost all the time
-        */
-        size_t currentlyUsedSize;
-
-        void* allocEnough(const uint32_t size);
+        void update_moved_watches(
+            Solver* solver
+            , const vector<ClOffset>& moved_from
+            , const vector<ClOffset>& moved_to
+        );
+        void new_slab(const size_t needed, const bool red);
+        void reserve(const size_t elems);
+        bool grow_reserved(const size_t elems);
+        void free_memory();
+
+        BASE_DATA_TYPE* dataStart; ///<Slabs start at dataStart + (index << slab_bits)
+        vector<Slab> slabs;
+        size_t cur_slab[2]; ///<New clauses are put here, indexed by redundancy
+        vector<uint32_t> reusable_slabs[2]; ///<Compacted slabs with at least half of them free
+        size_t maxSize; ///<The number of BASE_DATA_TYPE datapieces allocated or reserved
+        size_t num_cls; ///<Number of non-freed clauses
+        size_t currentlyUsedSize; ///<Sum of the slabs' estimated used sizes
+
+        void* reserved_start; ///<Start of the reserved mapping, dataStart is aligned inside it
+        size_t reserved_bytes;
+        bool reserved; ///<dataStart is an mmap-ed mapping of the first maxSize datapieces
+        ///dataStart is a copy-on-write mapping shared with other allocators
+        bool mapped;
+        bool huge_pages;
+
+        void* allocEnough(const uint32_t size, const bool red);
 };
 
 } //end namespace
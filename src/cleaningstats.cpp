@@ -44,6 +44,21 @@ void CleaningStats::print(const double total_cpu_time) const
             , cpu_time
         );
     }
+    print_stats_line("c reduceDB select time"
+        , select_time
+        , stats_line_percent(select_time, cpu_time)
+        , "% reduceDB time"
+    );
+    print_stats_line("c reduceDB remove time"
+        , remove_time
+        , stats_line_percent(remove_time, cpu_time)
+        , "% reduceDB time"
+    );
+    print_stats_line("c reduceDB free time"
+        , free_time
+        , stats_line_percent(free_time, cpu_time)
+        , "% reduceDB time"
+    );
 
     //-->CLEAN
     print_stats_line("c cleaned cls"
@@ -81,6 +96,26 @@ void CleaningStats::print(const double total_cpu_time) const
         , ratio_for_stat(remain.glue, remain.num)
     );
 
+    //--> TIERS
+    print_stats_line("c remain core"
+        , core
+        , stats_line_percent(core, remain.num)
+        , "% remain"
+    );
+    print_stats_line("c remain tier2"
+        , tier2
+        , stats_line_percent(tier2, remain.num)
+        , "% remain"
+    );
+    print_stats_line("c remain local"
+        , local
+        , stats_line_percent(local, remain.num)
+        , "% remain"
+    );
+    print_stats_line("c tier2 demoted"
+        , tier2_demoted
+    );
+
     cout << "c ------ REDUCEDB STATS END ---------" << endl;
 }
 
@@ -118,6 +153,9 @@ CleaningStats& CleaningStats::operator+=(const CleaningStats& other)
 {
     //Time
     cpu_time += other.cpu_time;
+    select_time += other.select_time;
+    remove_time += other.remove_time;
+    free_time += other.free_time;
 
     //Before remove
     origNumClauses += other.origNumClauses;
@@ -127,5 +165,11 @@ CleaningStats& CleaningStats::operator+=(const CleaningStats& other)
     removed += other.removed;
     remain += other.remain;
 
+    //Tiers
+    core += other.core;
+    tier2 += other.tier2;
+    local += other.local;
+    tier2_demoted += other.tier2_demoted;
+
     return *this;
 }
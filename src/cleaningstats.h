@@ -101,6 +101,9 @@ struct CleaningStats
     void print_short(const Solver* solver) const;
 
     double cpu_time = 0;
+    double select_time = 0; ///<Picking the clauses to keep
+    double remove_time = 0; ///<Removing the rest from longRedCls
+    double free_time = 0; ///<Cleaning the watchlists and freeing the clauses
 
     //Before remove
     uint64_t origNumClauses = 0;
@@ -109,6 +112,12 @@ struct CleaningStats
     //Clause Cleaning
     Data removed;
     Data remain;
+
+    //Tiers of the remaining clauses
+    uint64_t core = 0;
+    uint64_t tier2 = 0;
+    uint64_t local = 0;
+    uint64_t tier2_demoted = 0;
 };
 
 }
@@ -62,7 +62,7 @@ void CNF::new_var(const bool bva, const Var orig_outer)
         outerToInterMain[x] = maxVar;
 
         swapVars(nVarsOuter()-1);
-        varData[nVars()-1].is_bva = bva;
+        varDataCold[nVars()-1].is_bva = bva;
         if (bva) {
             num_bva_vars ++;
         } else {
@@ -128,7 +128,7 @@ void CNF::new_vars(const size_t n)
         outerToInterMain[x] = maxVar;
 
         swapVars(nVarsOuter()-i-1, i);
-        varData[nVars()-i-1].is_bva = false;
+        varDataCold[nVars()-i-1].is_bva = false;
         outer_to_with_bva_map.push_back(nVarsOuter()-i-1);
     }
 
@@ -141,16 +141,27 @@ void CNF::swapVars(const Var which, const int off_by)
 {
     std::swap(assigns[nVars()-off_by-1], assigns[which]);
     std::swap(varData[nVars()-off_by-1], varData[which]);
+    std::swap(varDataCold[nVars()-off_by-1], varDataCold[which]);
 
     #ifdef STATS_NEEDED
     std::swap(varDataLT[nVars()-off_by-1], varDataLT[which]);
     #endif
 }
 
+void CNF::reserve_assigns(size_t n)
+{
+    const size_t padded = (n + 3) & ~(size_t)3;
+    if (assigns.capacity() < padded) {
+        assigns.reserve(std::max(padded, 2*assigns.capacity()));
+    }
+}
+
 void CNF::enlarge_nonminimial_datastructs(size_t n)
 {
+    reserve_assigns(assigns.size() + n);
     assigns.resize(assigns.size() + n, l_Undef);
     varData.resize(varData.size() + n, VarData());
+    varDataCold.resize(varDataCold.size() + n, VarDataCold());
     #ifdef STATS_NEEDED
     varDataLT.resize(varDataLT.size() + n, VarData());
     #endif
@@ -165,7 +176,7 @@ void CNF::enlarge_minimal_datastructs(size_t n)
 
 void CNF::save_on_var_memory()
 {
-    //never resize varData --> contains info about what is replaced/etc.
+    //never resize varData(Cold) --> contains info about what is replaced/etc.
     //never resize assigns --> contains 0-level assigns
     //never resize interToOuterMain, outerToInterMain
 
@@ -233,6 +244,18 @@ uint64_t CNF::print_mem_used_longclauses(const size_t totalMem) const
         , stats_line_percent(mem, totalMem)
         , "%"
     );
+    if (cl_alloc.is_shared()) {
+        const uint64_t shared = cl_alloc.mem_shared();
+        print_stats_line("c Mem for longclauses shared"
+            , shared/(1024UL*1024UL)
+            , "MB"
+            , stats_line_percent(shared, mem)
+            , "% of longclauses"
+        );
+    }
+    HugePages::PageStats pages;
+    cl_alloc.count_pages(pages);
+    pages.print("longcls");
 
     return mem;
 }
@@ -375,7 +398,7 @@ vector<lbool> CNF::map_back_to_without_bva(const vector<lbool>& val) const
     assert(val.size() == nVarsOuter());
     ret.reserve(nVarsOutside());
     for(size_t i = 0; i < nVarsOuter(); i++) {
-        if (!varData[map_outer_to_inter(i)].is_bva) {
+        if (!varDataCold[map_outer_to_inter(i)].is_bva) {
             ret.push_back(val[i]);
         }
     }
@@ -388,7 +411,7 @@ vector<Var> CNF::build_outer_to_without_bva_map() const
     vector<Var> ret;
     size_t at = 0;
     for(size_t i = 0; i < nVarsOuter(); i++) {
-        if (!varData[map_outer_to_inter(i)].is_bva) {
+        if (!varDataCold[map_outer_to_inter(i)].is_bva) {
             ret.push_back(at);
             at++;
         } else {
@@ -422,6 +445,7 @@ void CNF::save_state(SimpleOutFile& f) const
 
     f.put_vector(assigns);
     f.put_vector(varData);
+    f.put_vector(varDataCold);
     f.put_uint32_t(minNumVars);
     f.put_uint32_t(num_bva_vars);
     f.put_uint32_t(ok);
@@ -438,7 +462,9 @@ void CNF::load_state(SimpleInFile& f)
     build_outer_to_without_bva_map();
 
     f.get_vector(assigns);
+    reserve_assigns(assigns.size());
     f.get_vector(varData);
+    f.get_vector(varDataCold);
     minNumVars = f.get_uint32_t();
     num_bva_vars = f.get_uint32_t();
     ok = f.get_uint32_t();
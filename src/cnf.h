@@ -34,6 +34,7 @@
 #include "clauseallocator.h"
 #include "varupdatehelper.h"
 #include "simplefile.h"
+#include <mutex>
 
 namespace CMSat {
 using namespace CMSat;
@@ -71,6 +72,8 @@ public:
         if (_conf != NULL) {
             conf = *_conf;
         }
+        cl_alloc.set_huge_pages(conf.huge_pages);
+        watches.set_huge_pages(conf.huge_pages);
         drup = new Drup();
         assert(_needToInterrupt != NULL);
         needToInterrupt = _needToInterrupt;
@@ -87,6 +90,7 @@ public:
     bool ok = true;
     watch_array watches;  ///< 'watches[lit]' is a list of constraints watching 'lit'
     vector<VarData> varData;
+    vector<VarDataCold> varDataCold;
     #ifdef STATS_NEEDED
     vector<VarData> varDataLT;
     #endif
@@ -96,6 +100,7 @@ public:
     vector<ClOffset> longIrredCls;          ///< List of problem clauses that are larger than 2
     int64_t num_red_cls_reducedb = 0;
     bool red_long_cls_is_reducedb(const Clause& cl) const;
+    void update_red_tier(ClauseStats& stats) const;
     int64_t count_num_red_cls_reducedb() const;
 
     vector<ClOffset> longRedCls;          ///< List of redundant clauses.
@@ -143,6 +148,44 @@ public:
         return needToInterrupt;
     }
 
+    //'mu' serializes the calls of solvers that share the callback
+    void set_terminate_callback(int (*callback)(void*), void* state, std::mutex* mu)
+    {
+        terminate_callback = callback;
+        terminate_callback_state = state;
+        terminate_callback_mu = mu;
+        terminate_last_poll = 0;
+    }
+
+    //Calls the user's terminate callback at most once every
+    //conf.terminate_poll_props units of 'work'. 'work' is the caller's own
+    //counter: propagations in search, bogoprops in the distiller and the
+    //prober, time limit units in variable elimination. These are all
+    //calibrated to about one propagation each. A decreasing 'work' means
+    //the caller switched or reset its counter, which also triggers a poll.
+    void poll_terminate_callback(const uint64_t work)
+    {
+        if (terminate_callback == NULL
+            || (work >= terminate_last_poll
+                && work - terminate_last_poll < conf.terminate_poll_props)
+        ) {
+            return;
+        }
+
+        terminate_last_poll = work;
+        std::unique_lock<std::mutex> lock;
+        if (terminate_callback_mu) {
+            lock = std::unique_lock<std::mutex>(*terminate_callback_mu);
+        }
+
+        //Another thread's poll may have stopped everybody already
+        if (!must_interrupt_asap()
+            && terminate_callback(terminate_callback_state)
+        ) {
+            set_must_interrupt_asap();
+        }
+    }
+
     bool clause_locked(const Clause& c, const ClOffset offset) const;
     void unmark_all_irred_clauses();
     void unmark_all_red_clauses();
@@ -256,6 +299,9 @@ protected:
     }
 
     vector<lbool> map_back_to_without_bva(const vector<lbool>& val) const;
+
+    //Capacity is at least size() rounded up to a multiple of 4:
+    //BinPropSIMD::not_true() gathers the aligned 32-bit word around a value
     vector<lbool> assigns;
 
     void save_state(SimpleOutFile& f) const;
@@ -263,8 +309,13 @@ protected:
 
 private:
     bool *needToInterrupt; ///<Interrupt cleanly ASAP if true
+    int (*terminate_callback)(void*) = NULL;
+    void* terminate_callback_state = NULL;
+    std::mutex* terminate_callback_mu = NULL;
+    uint64_t terminate_last_poll = 0;
     void enlarge_minimal_datastructs(size_t n = 1);
     void enlarge_nonminimial_datastructs(size_t n = 1);
+    void reserve_assigns(size_t n);
     void swapVars(const Var which, const int off_by = 0);
 
     vector<Var> outerToInterMain;
@@ -468,7 +519,28 @@ inline void CNF::renumber_outer_to_inter_lits(vector<Lit>& ps) const
 inline bool CNF::red_long_cls_is_reducedb(const Clause& cl) const
 {
     assert(cl.red());
-    return cl.stats.glue > conf.glue_must_keep_clause_if_below_or_eq && !cl.stats.locked && cl.stats.ttl == 0;
+    return cl.stats.glue > conf.glue_must_keep_clause_if_below_or_eq
+        && cl.stats.which_red_array == red_local
+        && !cl.stats.locked
+        && cl.stats.ttl == 0;
+}
+
+/**
+@brief Moves a redundant clause up to the tier its glue is good for
+
+Called whenever the glue of a redundant clause is set or lowered. For attached
+clauses the caller keeps num_red_cls_reducedb up to date. A clause only goes
+down a tier in ReduceDB, when it was not used while in tier2.
+*/
+inline void CNF::update_red_tier(ClauseStats& stats) const
+{
+    if (stats.glue <= conf.glue_must_keep_clause_if_below_or_eq) {
+        stats.which_red_array = red_core;
+    } else if (stats.glue <= conf.glue_put_tier2_if_below_or_eq
+        && stats.which_red_array == red_local
+    ) {
+        stats.which_red_array = red_tier2;
+    }
 }
 
 inline int64_t CNF::count_num_red_cls_reducedb() const
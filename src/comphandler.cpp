@@ -311,7 +311,7 @@ void CompHandler::check_local_vardata_sanity()
     for (Var outerVar = 0; outerVar < solver->nVarsOuter(); ++outerVar) {
         const Var interVar = solver->map_outer_to_inter(outerVar);
         if (savedState[outerVar] != l_Undef) {
-            assert(solver->varData[interVar].removed == Removed::decomposed);
+            assert(solver->varDataCold[interVar].removed == Removed::decomposed);
             assert(solver->value(interVar) == l_Undef || solver->varData[interVar].level == 0);
             num_vars_removed_check++;
         }
@@ -360,8 +360,8 @@ void CompHandler::move_decision_level_zero_vars_here(
         lit = Lit(smallsolver_to_bigsolver[lit.var()], lit.sign());
         assert(solver->value(lit) == l_Undef);
 
-        assert(solver->varData[lit.var()].removed == Removed::decomposed);
-        solver->varData[lit.var()].removed = Removed::none;
+        assert(solver->varDataCold[lit.var()].removed == Removed::decomposed);
+        solver->varDataCold[lit.var()].removed = Removed::none;
         solver->set_decision_var(lit.var());
         num_vars_removed--;
 
@@ -419,8 +419,8 @@ void CompHandler::moveVariablesBetweenSolvers(
         assert(compFinder->getVarComp(var) == comp);
         assert(solver->value(var) == l_Undef);
 
-        assert(solver->varData[var].removed == Removed::none);
-        solver->varData[var].removed = Removed::decomposed;
+        assert(solver->varDataCold[var].removed == Removed::none);
+        solver->varDataCold[var].removed = Removed::decomposed;
         num_vars_removed++;
     }
 }
@@ -740,7 +740,7 @@ void CompHandler::addSavedState(vector<lbool>& solution)
     for (size_t var = 0; var < savedState.size(); ++var) {
         if (savedState[var] != l_Undef) {
             const Var interVar = solver->map_outer_to_inter(var);
-            assert(solver->varData[interVar].removed == Removed::decomposed);
+            assert(solver->varDataCold[interVar].removed == Removed::decomposed);
 
             const lbool val = savedState[var];
             assert(solution[var] == l_Undef);
@@ -773,7 +773,7 @@ void CompHandler::readdRemovedClauses()
     //Avoid recursion, clear 'removed' status
     for(size_t outer = 0; outer < solver->nVarsOuter(); ++outer) {
         const Var inter = solver->map_outer_to_inter(outer);
-        VarData& dat = solver->varData[inter];
+        VarDataCold& dat = solver->varDataCold[inter];
         if (dat.removed == Removed::decomposed) {
             dat.removed = Removed::none;
             num_vars_removed--;
@@ -0,0 +1,245 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "cpuaffinity.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace CMSat;
+using std::string;
+
+CPUAffinity::CPUAffinity(const size_t num_threads, const Mode mode)
+{
+    #if defined(__linux__)
+    if (mode == Mode::none) {
+        return;
+    }
+
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    read_numa_layout();
+
+    vector<vector<int> > node_cpus(nodes);
+    size_t num_cpus = 0;
+    for(int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            const int node = cpu < (int)cpu_node.size() ? cpu_node[cpu] : 0;
+            node_cpus[node].push_back(cpu);
+            num_cpus++;
+        }
+    }
+    if (num_cpus == 0) {
+        return;
+    }
+
+    vector<int> order;
+    if (mode == Mode::compact) {
+        for(const vector<int>& cpus: node_cpus) {
+            order.insert(order.end(), cpus.begin(), cpus.end());
+        }
+    } else {
+        for(size_t i = 0; order.size() < num_cpus; i++) {
+            for(const vector<int>& cpus: node_cpus) {
+                if (i < cpus.size()) {
+                    order.push_back(cpus[i]);
+                }
+            }
+        }
+    }
+
+    for(size_t i = 0; i < num_threads; i++) {
+        thread_cpu.push_back(order[i % order.size()]);
+    }
+    #endif
+}
+
+static vector<int> parse_cpu_list(const string& str)
+{
+    vector<int> cpus;
+    std::stringstream ss(str);
+    string range;
+    while(std::getline(ss, range, ',')) {
+        const size_t dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = (dash == string::npos) ? first : std::stoi(range.substr(dash+1));
+        for(int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+void CPUAffinity::read_numa_layout()
+{
+    for(int node = 0; node < 256; node++) {
+        std::ifstream file(
+            "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        string line;
+        if (!file || !std::getline(file, line) || line.empty()) {
+            continue;
+        }
+
+        for(const int cpu: parse_cpu_list(line)) {
+            if (cpu >= (int)cpu_node.size()) {
+                cpu_node.resize(cpu+1, 0);
+            }
+            cpu_node[cpu] = node;
+        }
+        nodes = std::max<size_t>(nodes, node+1);
+    }
+}
+
+bool CPUAffinity::pin_this_thread(const size_t thread_num) const
+{
+    #if defined(__linux__)
+    if (thread_num >= thread_cpu.size()) {
+        return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(thread_cpu[thread_num], &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    #else
+    return false;
+    #endif
+}
+
+int CPUAffinity::cpu_of_thread(const size_t thread_num) const
+{
+    if (thread_num >= thread_cpu.size()) {
+        return -1;
+    }
+
+    return thread_cpu[thread_num];
+}
+
+int CPUAffinity::node_of_thread(const size_t thread_num) const
+{
+    const int cpu = cpu_of_thread(thread_num);
+    if (cpu < 0) {
+        return -1;
+    }
+    if (cpu >= (int)cpu_node.size()) {
+        return 0;
+    }
+
+    return cpu_node[cpu];
+}
+
+size_t CPUAffinity::num_nodes() const
+{
+    return nodes;
+}
+
+/**
+@brief Asks the kernel on which node the pages are
+
+Large ranges are sampled, at most 64K pages are looked at. Pages that have
+never been touched are not counted.
+*/
+void CPUAffinity::count_pages(
+    const void* start
+    , const size_t bytes
+    , const int node
+    , PageStats& stats
+) {
+    #if defined(__linux__) && defined(SYS_move_pages)
+    if (start == NULL || bytes == 0 || node < 0) {
+        return;
+    }
+
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const uintptr_t first = (uintptr_t)start / page_size * page_size;
+    const size_t num_pages = ((uintptr_t)start + bytes - first + page_size - 1) / page_size;
+    const size_t step = num_pages / (1ULL << 16) + 1;
+
+    vector<void*> pages;
+    for(size_t i = 0; i < num_pages; i += step) {
+        pages.push_back((void*)(first + i*page_size));
+    }
+    count_page_list(pages, step, node, stats);
+    #endif
+}
+
+void CPUAffinity::count_pages(
+    const vector<const void*>& addresses
+    , const int node
+    , PageStats& stats
+) {
+    #if defined(__linux__) && defined(SYS_move_pages)
+    if (node < 0) {
+        return;
+    }
+
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    vector<void*> pages;
+    for(const void* address: addresses) {
+        pages.push_back((void*)((uintptr_t)address / page_size * page_size));
+    }
+    std::sort(pages.begin(), pages.end());
+    pages.erase(std::unique(pages.begin(), pages.end()), pages.end());
+    count_page_list(pages, 1, node, stats);
+    #endif
+}
+
+void CPUAffinity::count_page_list(
+    vector<void*>& pages
+    , const uint64_t weight
+    , const int node
+    , PageStats& stats
+) {
+    #if defined(__linux__) && defined(SYS_move_pages)
+    if (pages.empty()) {
+        return;
+    }
+
+    vector<int> status(pages.size());
+    if (syscall(SYS_move_pages, 0, pages.size(), pages.data(), NULL, status.data(), 0) != 0) {
+        return;
+    }
+
+    for(const int page_node: status) {
+        if (page_node < 0) {
+            continue;
+        }
+
+        if (page_node == node) {
+            stats.local += weight;
+        } else {
+            stats.remote += weight;
+        }
+    }
+    #endif
+}
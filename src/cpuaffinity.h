@@ -0,0 +1,98 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __CPUAFFINITY_H__
+#define __CPUAFFINITY_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace CMSat {
+
+using std::vector;
+
+/**
+@brief Pins portfolio threads to CPUs and checks on which NUMA node memory is
+
+The NUMA layout is read from sysfs, so libnuma is not needed. Memory is not
+bound explicitly: a pinned thread first-touches its own Solver's memory, so
+the kernel places it on the thread's node. On systems other than Linux
+nothing is pinned and no pages are counted.
+*/
+class CPUAffinity
+{
+    public:
+        enum class Mode {
+            none = 0
+            , compact = 1 ///<Fill up the NUMA nodes one after the other
+            , scatter = 2 ///<Put threads on the NUMA nodes in turn
+        };
+
+        CPUAffinity(const size_t num_threads, const Mode mode);
+        bool pin_this_thread(const size_t thread_num) const;
+        int cpu_of_thread(const size_t thread_num) const;
+        int node_of_thread(const size_t thread_num) const;
+        size_t num_nodes() const;
+
+        struct PageStats
+        {
+            uint64_t local = 0;
+            uint64_t remote = 0;
+
+            PageStats& operator+=(const PageStats& other)
+            {
+                local += other.local;
+                remote += other.remote;
+                return *this;
+            }
+        };
+
+        //Counts the pages in [start, start+bytes) that are present in memory
+        static void count_pages(
+            const void* start
+            , const size_t bytes
+            , const int node
+            , PageStats& stats
+        );
+        //Counts the pages the addresses are on, every page only once
+        static void count_pages(
+            const vector<const void*>& addresses
+            , const int node
+            , PageStats& stats
+        );
+
+    private:
+        static void count_page_list(
+            vector<void*>& pages
+            , const uint64_t weight
+            , const int node
+            , PageStats& stats
+        );
+        void read_numa_layout();
+        vector<int> thread_cpu;
+        vector<int> cpu_node;
+        size_t nodes = 1;
+};
+
+}
+
+#endif //__CPUAFFINITY_H__
@@ -24,9 +24,16 @@
 #include "solver.h"
 #include "drup.h"
 #include "shareddata.h"
+#include "datasync.h"
+#include "cubefinder.h"
+#include "cpuaffinity.h"
 #include <stdexcept>
 #include <thread>
 #include <mutex>
+#include <deque>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
 #include <fstream>
 #include <cstdlib>
 using std::thread;
@@ -47,11 +54,14 @@ namespace CMSat {
             which_solved = 0;
             shared_data = NULL;
             okay = true;
+            solvers_in_sync = true;
+            xor_in_cls_lits = false;
         }
         ~CMSatPrivateData()
         {
             delete log; //this will also close the file
             delete shared_data;
+            delete affinity;
         }
         CMSatPrivateData(CMSatPrivateData&) //copy should fail
         {
@@ -70,6 +80,12 @@ namespace CMSat {
         unsigned cls;
         unsigned vars_to_add;
         vector<Lit> cls_lits;
+        bool solvers_in_sync; ///<No solving yet, all solvers are in the same state
+        bool xor_in_cls_lits;
+        LoadedClauses deferred_loaded; ///<Loaded by the first solver only, the others will share them
+        CPUAffinity* affinity = NULL;
+        std::mutex learnt_callback_mutex;
+        std::mutex terminate_callback_mutex;
         bool okay;
         std::ofstream* log = NULL;
     };
@@ -85,9 +101,18 @@ struct DataForThread
         , update_mutex(new mutex)
         , which_solved(&(data->which_solved))
         , ret(new lbool(l_Undef))
+        , deterministic(data->solvers[0]->getConf().deterministic_sync)
+        , affinity(data->affinity)
     {
     }
 
+    void pin_thread(const size_t tid) const
+    {
+        if (affinity) {
+            affinity->pin_this_thread(tid);
+        }
+    }
+
     ~DataForThread()
     {
         delete update_mutex;
@@ -100,6 +125,8 @@ struct DataForThread
     mutex* update_mutex;
     int *which_solved;
     lbool* ret;
+    bool deterministic;
+    const CPUAffinity* affinity;
 };
 
 DLL_PUBLIC SATSolver::SATSolver(void* config, bool* interrupt_asap)
@@ -265,6 +292,25 @@ DLL_PUBLIC void SATSolver::set_num_threads(const unsigned num)
         exit(-1);
     }
 
+    const unsigned ring_size_log2 = data->solvers[0]->getConf().share_ring_size_log2;
+    if (ring_size_log2 < 4 || ring_size_log2 > 24) {
+        std::cerr << "ERROR: Clause sharing ring size must be between 2^4 and 2^24" << endl;
+        exit(-1);
+    }
+
+    const int pinning = data->solvers[0]->getConf().thread_pinning;
+    if (pinning < (int)CPUAffinity::Mode::none || pinning > (int)CPUAffinity::Mode::scatter) {
+        std::cerr << "ERROR: Thread pinning must be 0 (none), 1 (compact) or 2 (scatter)" << endl;
+        exit(-1);
+    }
+
+    if (data->solvers[0]->getConf().do_cube_and_conquer
+        && data->solvers[0]->getConf().deterministic_sync
+    ) {
+        std::cerr << "ERROR: Cube-and-conquer cannot be used in deterministic mode" << endl;
+        exit(-1);
+    }
+
     data->cls_lits.reserve(CACHE_SIZE);
     for(unsigned i = 1; i < num; i++) {
         SolverConf conf = data->solvers[0]->getConf();
@@ -274,7 +320,7 @@ DLL_PUBLIC void SATSolver::set_num_threads(const unsigned num)
     }
 
     //set shared data
-    data->shared_data = new SharedData(data->solvers.size());
+    data->shared_data = new SharedData(data->solvers.size(), ring_size_log2);
     for(unsigned i = 0; i < num; i++) {
         SolverConf conf = data->solvers[i]->getConf();
         if (i >= 1) {
@@ -283,24 +329,35 @@ DLL_PUBLIC void SATSolver::set_num_threads(const unsigned num)
             conf.doFindXors = 0;
         }
         data->solvers[i]->setConf(conf);
-        data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
+        data->solvers[i]->set_shared_data((SharedData*)data->shared_data, i);
+        data->solvers[i]->learnt_callback = data->solvers[0]->learnt_callback;
+    }
+
+    if (pinning != 0) {
+        data->affinity = new CPUAffinity(num, (CPUAffinity::Mode)pinning);
     }
 }
 
 struct OneThreadAddCls
 {
-    OneThreadAddCls(DataForThread& _data_for_thread, size_t _tid) :
+    OneThreadAddCls(
+        DataForThread& _data_for_thread
+        , size_t _tid
+        , LoadedClauses* _loaded = NULL
+    ) :
         data_for_thread(_data_for_thread)
         , tid(_tid)
+        , loaded(_loaded)
     {
     }
 
     void operator()()
     {
+        //Memory is first touched here, so it ends up on the node of the thread
+        data_for_thread.pin_thread(tid);
         Solver& solver = *data_for_thread.solvers[tid];
         solver.new_external_vars(data_for_thread.vars_to_add);
 
-        vector<Lit> lits;
         vector<Var> vars;
         bool ret = true;
         size_t at = 0;
@@ -308,16 +365,18 @@ struct OneThreadAddCls
         const size_t size = orig_lits.size();
         while(at < size && ret) {
             if (orig_lits[at] == lit_Undef) {
-                lits.clear();
-                at++;
-                for(; at < size
-                    && orig_lits[at] != lit_Undef
-                    && orig_lits[at] != lit_Error
-                    ; at++
-                ) {
-                    lits.push_back(orig_lits[at]);
+                //All clauses up to the next XOR go in as one batch
+                size_t end = at+1;
+                while(end < size && orig_lits[end] != lit_Error) {
+                    end++;
+                }
+                ret = solver.add_clauses_outer(orig_lits.data()+at+1, end-at-1, loaded);
+
+                //A batch cannot end with an empty clause
+                if (ret && orig_lits[end-1] == lit_Undef) {
+                    ret = solver.add_clause_outer(vector<Lit>(), loaded);
                 }
-                ret = solver.add_clause_outer(lits);
+                at = end;
             } else {
                 vars.clear();
                 at++;
@@ -343,23 +402,127 @@ struct OneThreadAddCls
 
     DataForThread& data_for_thread;
     const size_t tid;
+    LoadedClauses* loaded;
+};
+
+struct OneThreadCloneCls
+{
+    OneThreadCloneCls(
+        DataForThread& _data_for_thread
+        , size_t _tid
+        , const LoadedClauses& _loaded
+        , const bool _arena_shared = false
+    ) :
+        data_for_thread(_data_for_thread)
+        , tid(_tid)
+        , loaded(_loaded)
+        , arena_shared(_arena_shared)
+    {
+    }
+
+    void operator()()
+    {
+        data_for_thread.pin_thread(tid);
+        Solver& solver = *data_for_thread.solvers[tid];
+        solver.new_external_vars(data_for_thread.vars_to_add);
+
+        if (!solver.clone_loaded_clauses(*data_for_thread.solvers[0], loaded, arena_shared)) {
+            data_for_thread.update_mutex->lock();
+            *data_for_thread.ret = l_False;
+            data_for_thread.update_mutex->unlock();
+        }
+    }
+
+    DataForThread& data_for_thread;
+    const size_t tid;
+    const LoadedClauses& loaded;
+    const bool arena_shared;
 };
 
+/**
+@brief Gives the other threads the clauses only the first thread has loaded
+
+If possible, the threads share the memory of the long clauses copy-on-write,
+otherwise they get their own copy.
+*/
+static bool clone_deferred_clauses(CMSatPrivateData* data)
+{
+    LoadedClauses& loaded = data->deferred_loaded;
+    if (loaded.units.empty() && loaded.bins.empty()
+        && loaded.tris.empty() && loaded.longs.empty()
+    ) {
+        return data->okay;
+    }
+
+    vector<ClauseAllocator*> allocs;
+    for(Solver* solver: data->solvers) {
+        allocs.push_back(&solver->cl_alloc);
+    }
+    const bool shared = ClauseAllocator::share_copy_on_write(allocs);
+    if (data->solvers[0]->getConf().verbosity >= 1) {
+        cout
+        << "c [cow] long irred clauses shared between threads: "
+        << (shared ? "yes" : "no")
+        << " cls: " << loaded.longs.size()
+        << " MB: " << data->solvers[0]->cl_alloc.mem_used()/(1024UL*1024UL)
+        << endl;
+    }
+
+    DataForThread data_for_thread(data);
+    data_for_thread.vars_to_add = 0;
+    std::vector<std::thread> thds;
+    for(size_t i = 1; i < data->solvers.size(); i++) {
+        thds.push_back(thread(OneThreadCloneCls(data_for_thread, i, loaded, shared)));
+    }
+    for(std::thread& thread : thds){
+        thread.join();
+    }
+    bool ret = (*data_for_thread.ret != l_False);
+    if (!ret) {
+        data->okay = false;
+    }
+    loaded = LoadedClauses();
+
+    return ret;
+}
+
 static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
 {
+    if (data->cls_lits.empty() && data->vars_to_add == 0) {
+        return data->okay;
+    }
+
     DataForThread data_for_thread(data);
     std::vector<std::thread> thds;
-    for(size_t i = 0; i < data->solvers.size(); i++) {
-        thds.push_back(thread(OneThreadAddCls(data_for_thread, i)));
+    LoadedClauses loaded;
+    if (data->solvers_in_sync && !data->xor_in_cls_lits) {
+        //Normalize only once, then copy the result to the other threads.
+        //To share memory, the copying is deferred until the loading is done
+        const bool defer = data->solvers[0]->getConf().share_irred_arena;
+        thread loader(OneThreadAddCls(
+            data_for_thread, 0, defer ? &data->deferred_loaded : &loaded));
+        loader.join();
+        for(size_t i = 1; i < data->solvers.size(); i++) {
+            thds.push_back(thread(OneThreadCloneCls(data_for_thread, i, loaded)));
+        }
+    } else {
+        clone_deferred_clauses(data);
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            thds.push_back(thread(OneThreadAddCls(data_for_thread, i)));
+        }
     }
     for(std::thread& thread : thds){
         thread.join();
     }
-    bool ret = (*data_for_thread.ret == l_True);
+    bool ret = (*data_for_thread.ret != l_False);
+    if (!ret) {
+        data->okay = false;
+    }
 
     //clear what has been added
     data->cls_lits.clear();
     data->vars_to_add = 0;
+    data->xor_in_cls_lits = false;
 
     return ret;
 }
@@ -445,6 +608,46 @@ DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
     return ret;
 }
 
+DLL_PUBLIC bool SATSolver::add_clauses(const Lit* lits, const size_t num_lits)
+{
+    if (num_lits == 0) {
+        return data->okay;
+    }
+
+    if (data->log) {
+        for(size_t i = 0; i < num_lits; i++) {
+            if (lits[i] == lit_Undef) {
+                (*data->log) << "0" << endl;
+            } else {
+                (*data->log) << lits[i] << " ";
+            }
+        }
+        if (lits[num_lits-1] != lit_Undef) {
+            (*data->log) << "0" << endl;
+        }
+    }
+
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        if (data->cls_lits.size() + num_lits + 1 > CACHE_SIZE) {
+            ret = actually_add_clauses_to_threads(data);
+        }
+
+        //Stored with the separator in front: the last terminator is not needed
+        const size_t stored = num_lits - (lits[num_lits-1] == lit_Undef);
+        data->cls_lits.push_back(lit_Undef);
+        data->cls_lits.insert(data->cls_lits.end(), lits, lits + stored);
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_clauses_outer(lits, num_lits);
+        data->cls++;
+    }
+
+    return ret;
+}
+
 void add_xor_clause_to_log(const std::vector<unsigned>& vars, bool rhs, std::ofstream* file)
 {
     if (vars.size() == 0) {
@@ -474,6 +677,8 @@ DLL_PUBLIC bool SATSolver::add_xor_clause(const std::vector<unsigned>& vars, boo
             ret = actually_add_clauses_to_threads(data);
         }
 
+        //Cutting the XOR adds variables, it cannot be cloned
+        data->xor_in_cls_lits = true;
         data->cls_lits.push_back(lit_Error);
         data->cls_lits.push_back(Lit(0, rhs));
         for(Var var: vars) {
@@ -499,14 +704,13 @@ struct OneThreadSolve
 
     void operator()()
     {
+        data_for_thread.pin_thread(tid);
         if (print_thread_start_and_finish) {
             data_for_thread.update_mutex->lock();
             cout << "Starting thread" << tid << endl;
             data_for_thread.update_mutex->unlock();
         }
 
-        OneThreadAddCls cls_adder(data_for_thread, tid);
-        cls_adder();
         lbool ret = data_for_thread.solvers[tid]->solve_with_assumptions(data_for_thread.assumptions);
 
         if (print_thread_start_and_finish) {
@@ -516,7 +720,10 @@ struct OneThreadSolve
         }
 
 
-        if (ret != l_Undef) {
+        if (data_for_thread.deterministic) {
+            //Winner is decided once all threads have finished
+            data_for_thread.solvers[tid]->datasync->det_finish(ret);
+        } else if (ret != l_Undef) {
             data_for_thread.update_mutex->lock();
             *data_for_thread.which_solved = tid;
             *data_for_thread.ret = ret;
@@ -531,6 +738,229 @@ struct OneThreadSolve
     const size_t tid;
 };
 
+/**
+@brief Cubes for cube-and-conquer, balanced by work stealing
+
+Every thread has its own deque. It takes work from the back of its own, and
+when that is empty, steals from the front of the others'. Cubes next to each
+other share most of their literals, so they are handed out in contiguous
+blocks: learnt clauses from one cube then tend to help with the next one.
+*/
+struct CubeQueue
+{
+    CubeQueue(const vector<vector<Lit> >& cubes, const size_t num_threads) :
+        queues(num_threads)
+        , mutexes(num_threads)
+        , num_cubes(cubes.size())
+    {
+        for(size_t i = 0; i < cubes.size(); i++) {
+            queues[i*num_threads/cubes.size()].push_back(cubes[i]);
+        }
+        done = false;
+        steals = 0;
+        refuted = 0;
+        dropped = 0;
+    }
+
+    bool pop(const size_t tid, vector<Lit>& cube)
+    {
+        {
+            std::lock_guard<mutex> lock(mutexes[tid]);
+            if (!queues[tid].empty()) {
+                cube = std::move(queues[tid].back());
+                queues[tid].pop_back();
+                return true;
+            }
+        }
+
+        for(size_t i = 1; i < queues.size(); i++) {
+            const size_t victim = (tid + i) % queues.size();
+            std::lock_guard<mutex> lock(mutexes[victim]);
+            if (!queues[victim].empty()) {
+                cube = std::move(queues[victim].front());
+                queues[victim].pop_front();
+                steals++;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    vector<std::deque<vector<Lit> > > queues;
+    vector<mutex> mutexes;
+    const size_t num_cubes;
+    std::atomic<bool> done;
+    std::atomic<uint64_t> steals;
+    std::atomic<uint64_t> refuted;
+    std::atomic<uint64_t> dropped; ///<Refuted by units before being solved
+};
+
+struct OneThreadCube
+{
+    OneThreadCube(DataForThread& _data_for_thread, CubeQueue& _cube_queue, size_t _tid) :
+        data_for_thread(_data_for_thread)
+        , cube_queue(_cube_queue)
+        , tid(_tid)
+    {}
+
+    void operator()()
+    {
+        data_for_thread.pin_thread(tid);
+        Solver& solver = *data_for_thread.solvers[tid];
+        vector<Lit> cube;
+        while(!cube_queue.done && cube_queue.pop(tid, cube)) {
+            if (solver.cube_refuted_at_zero(cube)) {
+                cube_queue.dropped++;
+                continue;
+            }
+
+            //Learnt clauses are kept, they are valid for all cubes
+            const lbool ret = solver.solve_with_assumptions(&cube);
+            if (ret == l_False && !solver.get_final_conflict().empty()) {
+                cube_queue.refuted++;
+                continue;
+            }
+
+            //SAT, UNSAT without the cube, or interrupted: stop everybody
+            if (ret != l_Undef) {
+                data_for_thread.update_mutex->lock();
+                if (*data_for_thread.ret == l_Undef) {
+                    *data_for_thread.which_solved = tid;
+                    *data_for_thread.ret = ret;
+                }
+                data_for_thread.update_mutex->unlock();
+            }
+            cube_queue.done = true;
+            solver.set_must_interrupt_asap();
+            break;
+        }
+    }
+
+    DataForThread& data_for_thread;
+    CubeQueue& cube_queue;
+    const size_t tid;
+};
+
+/**
+@brief Prints how much of each thread's memory is on another NUMA node
+
+Looks at the clauses, the watchlists and the variable data. Only a sample of
+the watchlists is looked at when there are many.
+*/
+static void print_numa_stats(CMSatPrivateData* data)
+{
+    if (data->affinity == NULL
+        || data->solvers[0]->getConf().verbosity < 1
+    ) {
+        return;
+    }
+
+    CPUAffinity::PageStats total;
+    for(size_t i = 0; i < data->solvers.size(); i++) {
+        const Solver& solver = *data->solvers[i];
+        const int node = data->affinity->node_of_thread(i);
+        CPUAffinity::PageStats cls;
+        CPUAffinity::PageStats watches;
+        CPUAffinity::PageStats vardata;
+        CPUAffinity::count_pages(
+            solver.cl_alloc.get_data_start()
+            , solver.cl_alloc.get_data_size()
+            , node
+            , cls
+        );
+        vector<const void*> watch_addresses;
+        const size_t step = solver.watches.size()/(1U << 16) + 1;
+        for(size_t at = 0; at < solver.watches.size(); at += step) {
+            watch_subarray_const ws = solver.watches[at];
+            if (ws.size() > 0) {
+                watch_addresses.push_back(ws.begin());
+                watch_addresses.push_back(ws.end() - 1);
+            }
+        }
+        CPUAffinity::count_pages(watch_addresses, node, watches);
+        CPUAffinity::count_pages(
+            solver.varData.data()
+            , solver.varData.size()*sizeof(VarData)
+            , node
+            , vardata
+        );
+
+        cout
+        << "c [numa] thread " << i
+        << " cpu " << data->affinity->cpu_of_thread(i)
+        << " node " << node
+        << " remote/all pages --"
+        << " clauses: " << cls.remote << "/" << cls.local + cls.remote
+        << " watches: " << watches.remote << "/" << watches.local + watches.remote
+        << " vardata: " << vardata.remote << "/" << vardata.local + vardata.remote
+        << endl;
+        total += cls;
+        total += watches;
+        total += vardata;
+    }
+
+    cout
+    << "c [numa] nodes: " << data->affinity->num_nodes()
+    << " remote pages: " << total.remote
+    << " (" << std::fixed << std::setprecision(2)
+    << stats_line_percent(total.remote, total.local + total.remote)
+    << " %)"
+    << endl;
+}
+
+static lbool solve_with_cubes(CMSatPrivateData* data)
+{
+    Solver& solver = *data->solvers[0];
+    data->which_solved = 0;
+
+    uint32_t depth = solver.getConf().cube_depth;
+    if (depth == 0) {
+        depth = std::ceil(std::log2(data->solvers.size())) + 4;
+    }
+    vector<vector<Lit> > cubes;
+    CubeFinder cube_finder(&solver);
+    if (!cube_finder.find_cubes(depth, cubes)) {
+        data->okay = false;
+        return l_False;
+    }
+
+    lbool real_ret = l_Undef;
+    CubeQueue cube_queue(cubes, data->solvers.size());
+    if (!cubes.empty()) {
+        DataForThread data_for_thread(data);
+        std::vector<std::thread> thds;
+        for(size_t i = 0; i < data->solvers.size(); i++) {
+            thds.push_back(thread(OneThreadCube(data_for_thread, cube_queue, i)));
+        }
+        for(std::thread& thread : thds){
+            thread.join();
+        }
+        real_ret = *data_for_thread.ret;
+        *(data->must_interrupt) = false;
+    }
+
+    if (real_ret == l_Undef
+        && cube_queue.refuted + cube_queue.dropped == cube_queue.num_cubes
+    ) {
+        data->which_solved = 0;
+        solver.set_unsat_all_cubes_refuted();
+        real_ret = l_False;
+    }
+
+    if (solver.getConf().verbosity >= 1) {
+        cout
+        << "c [cube] refuted: " << cube_queue.refuted
+        << " dropped due to units: " << cube_queue.dropped
+        << " steals: " << cube_queue.steals
+        << endl;
+    }
+
+    data->okay = data->solvers[data->which_solved]->okay();
+    print_numa_stats(data);
+    return real_ret;
+}
+
 DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions)
 {
     //Reset the interrupt signal if it was set
@@ -553,7 +983,22 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions)
         return ret;
     }
 
+    //All clauses are loaded before solving, while they can still be cloned
+    actually_add_clauses_to_threads(data);
+    clone_deferred_clauses(data);
+    data->solvers_in_sync = false;
+
+    //Cubes are solved as assumptions, they cannot be mixed with the user's
+    if (data->solvers[0]->getConf().do_cube_and_conquer
+        && (assumptions == NULL || assumptions->empty())
+    ) {
+        return solve_with_cubes(data);
+    }
+
     DataForThread data_for_thread(data, assumptions);
+    if (data_for_thread.deterministic) {
+        data->shared_data->det_reset();
+    }
     std::vector<std::thread> thds;
     for(size_t i = 0; i < data->solvers.size(); i++) {
         thds.push_back(thread(OneThreadSolve(data_for_thread, i)));
@@ -562,11 +1007,15 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions)
         thread.join();
     }
     lbool real_ret = *data_for_thread.ret;
+    if (data_for_thread.deterministic) {
+        real_ret = data->shared_data->det_winner(data->which_solved);
+    }
 
     //clear what has been added
     data->cls_lits.clear();
     data->vars_to_add = 0;
     data->okay = data->solvers[*data_for_thread.which_solved]->okay();
+    print_numa_stats(data);
 
     return real_ret;
 }
@@ -632,6 +1081,20 @@ DLL_PUBLIC void SATSolver::print_stats() const
     data->solvers[data->which_solved]->print_stats();
 }
 
+DLL_PUBLIC unsigned long SATSolver::get_num_sync_rounds() const
+{
+    const DataSync* datasync = data->solvers[data->which_solved]->datasync;
+    if (datasync == NULL) {
+        return 0;
+    }
+    return datasync->get_stats().detRounds;
+}
+
+DLL_PUBLIC unsigned long SATSolver::get_num_chrono_backtracks() const
+{
+    return data->solvers[data->which_solved]->get_stats().chronoBacktrack;
+}
+
 DLL_PUBLIC void SATSolver::set_drup(std::ostream* os)
 {
     if (data->solvers.size() > 1) {
@@ -651,6 +1114,55 @@ DLL_PUBLIC void SATSolver::interrupt_asap()
     *(data->must_interrupt) = true;
 }
 
+DLL_PUBLIC void SATSolver::set_learnt_callback(
+    unsigned max_size
+    , unsigned max_glue
+    , void (*learnt)(void* state, const std::vector<Lit>& lits, unsigned glue)
+    , void* state
+) {
+    LearntCallback callback;
+    callback.func = learnt;
+    callback.state = state;
+    callback.max_size = max_size;
+    callback.max_glue = max_glue;
+    callback.mu = &data->learnt_callback_mutex;
+    for(Solver* solver: data->solvers) {
+        solver->learnt_callback = callback;
+    }
+}
+
+DLL_PUBLIC bool SATSolver::add_learnt_clause(const vector<Lit>& lits, unsigned glue)
+{
+    if (data->solvers.size() > 1) {
+        //The threads' states diverge from here on, so nothing is cloned later
+        actually_add_clauses_to_threads(data);
+        clone_deferred_clauses(data);
+        data->solvers_in_sync = false;
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+    }
+
+    bool ret = true;
+    for(Solver* solver: data->solvers) {
+        ret &= solver->add_red_clause_outer(lits, glue);
+    }
+    if (!ret) {
+        data->okay = false;
+    }
+
+    return ret;
+}
+
+DLL_PUBLIC void SATSolver::set_terminate_callback(int (*terminate)(void* state), void* state)
+{
+    //Every thread polls, as in cube-and-conquer mode any of them may be the
+    //last one running. The interrupt flag is shared between all threads
+    for(Solver* solver: data->solvers) {
+        solver->set_terminate_callback(terminate, state, &data->terminate_callback_mutex);
+    }
+}
+
 DLL_PUBLIC void SATSolver::open_file_and_dump_irred_clauses(std::string fname) const
 {
     data->solvers[data->which_solved]->open_file_and_dump_irred_clauses(fname);
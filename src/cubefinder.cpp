@@ -0,0 +1,171 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "cubefinder.h"
+#include "solver.h"
+#include "time_mem.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace CMSat;
+
+CubeFinder::CubeFinder(Solver* _solver) :
+    solver(_solver)
+{}
+
+bool CubeFinder::find_cubes(const uint32_t depth, vector<vector<Lit> >& _cubes)
+{
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    runStats = Stats();
+    cubes = &_cubes;
+    cubes->clear();
+    decisions.clear();
+    if (!solver->okay()) {
+        return false;
+    }
+
+    solver->ok = solver->propagate<true>().isNULL();
+    if (!solver->okay()) {
+        return false;
+    }
+    outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+
+    split(depth);
+    solver->cancelUntil<false>(0);
+    runStats.cpu_time = cpuTime() - myTime;
+
+    if (solver->conf.verbosity >= 1) {
+        runStats.print_short(cubes->size());
+    }
+
+    return solver->okay();
+}
+
+void CubeFinder::split(const uint32_t depth)
+{
+    const Lit lit = depth == 0 ? lit_Undef : pick_split_lit();
+    if (lit == lit_Undef) {
+        vector<Lit> cube;
+        for(const Lit dec: decisions) {
+            const Lit outer = solver->map_inter_to_outer(dec);
+            cube.push_back(Lit(outer_to_without_bva_map[outer.var()], outer.sign()));
+        }
+        cubes->push_back(cube);
+        return;
+    }
+
+    const uint32_t level = solver->decisionLevel();
+    for(const Lit branch: {lit, ~lit}) {
+        solver->new_decision_level();
+        solver->enqueue(branch);
+        if (solver->propagate<true>().isNULL()) {
+            decisions.push_back(branch);
+            split(depth-1);
+            decisions.pop_back();
+        } else {
+            runStats.refuted++;
+        }
+        solver->cancelUntil<false>(level);
+    }
+}
+
+//Number of literals set by propagating 'lit', 0 if it fails
+size_t CubeFinder::propagate_count(const Lit lit)
+{
+    runStats.lookaheads++;
+    const uint32_t level = solver->decisionLevel();
+    const size_t trail_at = solver->trail_size();
+    solver->new_decision_level();
+    solver->enqueue(lit);
+    const bool failed = !solver->propagate<true>().isNULL();
+    const size_t num = solver->trail_size() - trail_at;
+    solver->cancelUntil<false>(level);
+
+    return failed ? 0 : num;
+}
+
+void CubeFinder::fill_candidates()
+{
+    candidates.clear();
+    for(Var var = 0; var < solver->nVars(); var++) {
+        if (solver->value(var) == l_Undef
+            && solver->varDataCold[var].removed == Removed::none
+            && !solver->varDataCold[var].is_bva
+        ) {
+            candidates.push_back(var);
+        }
+    }
+
+    //Only look ahead on the variables occurring most
+    const auto occur = [&](const Var var) {
+        return solver->watches[Lit(var, false).toInt()].size()
+            + solver->watches[Lit(var, true).toInt()].size();
+    };
+    const size_t max_cands = solver->conf.cube_lookahead_vars;
+    if (candidates.size() > max_cands) {
+        std::partial_sort(candidates.begin(), candidates.begin() + max_cands, candidates.end()
+            , [&](const Var a, const Var b) {
+                return occur(a) > occur(b);
+            }
+        );
+        candidates.resize(max_cands);
+    }
+}
+
+Lit CubeFinder::pick_split_lit()
+{
+    fill_candidates();
+
+    Lit best = lit_Undef;
+    uint64_t best_score = 0;
+    for(const Var var: candidates) {
+        const Lit lit = Lit(var, false);
+        const size_t pos = propagate_count(lit);
+        const size_t neg = propagate_count(~lit);
+
+        //Failed literal under the current cube: split on it, one of the
+        //branches will be refuted straight away
+        if (pos == 0 || neg == 0) {
+            runStats.failed_lits++;
+            return pos == 0 ? lit : ~lit;
+        }
+
+        const uint64_t score = (uint64_t)pos*(uint64_t)neg;
+        if (score > best_score) {
+            best_score = score;
+            best = neg > pos ? ~lit : lit;
+        }
+    }
+
+    return best;
+}
+
+void CubeFinder::Stats::print_short(const size_t num_cubes) const
+{
+    cout
+    << "c [cube] cubes: " << num_cubes
+    << " refuted: " << refuted
+    << " failed lits: " << failed_lits
+    << " lookaheads: " << lookaheads
+    << " T: " << std::fixed << std::setprecision(2) << cpu_time
+    << endl;
+}
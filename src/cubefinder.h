@@ -0,0 +1,82 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __CUBEFINDER_H__
+#define __CUBEFINDER_H__
+
+#include <vector>
+#include "solvertypes.h"
+
+namespace CMSat {
+
+using std::vector;
+
+class Solver;
+
+/**
+@brief Splits the problem into cubes for cube-and-conquer
+
+Builds a binary decision tree of the given depth. At every node the variable
+to split on is picked by lookahead: both polarities of the candidates are
+propagated and the one maximising the product of the number of propagated
+literals is chosen. Branches that fail during propagation are refuted right
+away and produce no cube. Cubes are returned in outside numbering, ready to
+be used as assumptions.
+*/
+class CubeFinder
+{
+public:
+    explicit CubeFinder(Solver* solver);
+    bool find_cubes(const uint32_t depth, vector<vector<Lit> >& cubes);
+
+    struct Stats
+    {
+        void print_short(const size_t num_cubes) const;
+
+        double cpu_time = 0;
+        uint64_t lookaheads = 0;
+        uint64_t refuted = 0;
+        uint64_t failed_lits = 0;
+    };
+    const Stats& get_stats() const;
+
+private:
+    void split(const uint32_t depth);
+    Lit pick_split_lit();
+    void fill_candidates();
+    size_t propagate_count(const Lit lit);
+
+    Solver* solver;
+    vector<Lit> decisions;
+    vector<Var> candidates;
+    vector<Var> outer_to_without_bva_map;
+    vector<vector<Lit> >* cubes;
+    Stats runStats;
+};
+
+inline const CubeFinder::Stats& CubeFinder::get_stats() const
+{
+    return runStats;
+}
+
+}
+
+#endif //__CUBEFINDER_H__
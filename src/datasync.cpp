@@ -27,12 +27,19 @@
 
 using namespace CMSat;
 
-DataSync::DataSync(Solver* _solver, SharedData* _sharedData) :
+DataSync::DataSync(Solver* _solver, SharedData* _sharedData, uint32_t _thread_num) :
     solver(_solver)
     , sharedData(_sharedData)
-    , seen(solver->seen)
-    , toClear(solver->toClear)
-{}
+    , thread_num(_thread_num)
+{
+    if (sharedData) {
+        assert(thread_num < sharedData->rings.size());
+        ringPos.resize(sharedData->rings.size(), 0);
+        import_glue_limit = solver->conf.share_long_max_glue;
+        export_glue_limit = import_glue_limit;
+        sharedData->wanted_glue[thread_num].store(import_glue_limit, std::memory_order_relaxed);
+    }
+}
 
 void DataSync::new_var(const bool bva)
 {
@@ -40,10 +47,9 @@ void DataSync::new_var(const bool bva)
         return;
 
     if (!bva) {
-        syncFinish.push_back(0);
-        syncFinish.push_back(0);
+        unitShared.push_back(false);
     }
-    assert(solver->nVarsOutside()*2 == syncFinish.size());
+    assert(solver->nVarsOutside() == unitShared.size());
 }
 
 void DataSync::new_vars(size_t n)
@@ -51,8 +57,8 @@ void DataSync::new_vars(size_t n)
     if (!enabled())
         return;
 
-    syncFinish.resize(syncFinish.size() + 2*n, 0);
-    assert(solver->nVarsOutside()*2 == syncFinish.size());
+    unitShared.resize(unitShared.size() + n, false);
+    assert(solver->nVarsOutside() == unitShared.size());
 }
 
 void DataSync::save_on_var_memory()
@@ -64,6 +70,14 @@ void DataSync::rebuild_bva_map()
     must_rebuild_bva_map = true;
 }
 
+void DataSync::rebuild_bva_map_if_needed()
+{
+    if (must_rebuild_bva_map) {
+        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+        must_rebuild_bva_map = false;
+    }
+}
+
 void DataSync::updateVars(
     const vector<uint32_t>& /*outerToInter*/
     , const vector<uint32_t>& /*interToOuter*/
@@ -72,259 +86,317 @@ void DataSync::updateVars(
 
 bool DataSync::syncData()
 {
-    if (!enabled()
-        || lastSyncConf + solver->conf.sync_every_confl >= solver->sumConflicts()
-    ) {
-        //cout << "sharedData:" << sharedData << endl;
-        //cout << "conf: " << solver->sumConflicts() << endl;
-        //cout << "todo: " << lastSyncConf + SYNC_EVERY_CONFL << endl;
+    if (!enabled()) {
         return true;
     }
 
     assert(sharedData != NULL);
     assert(solver->decisionLevel() == 0);
-
-    if (must_rebuild_bva_map) {
-        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
-        must_rebuild_bva_map = false;
+    rebuild_bva_map_if_needed();
+    if (solver->conf.deterministic_sync) {
+        return det_syncData();
     }
 
-    bool ok;
-    sharedData->unit_mutex.lock();
-    ok = shareUnitData();
-    sharedData->unit_mutex.unlock();
-    if (!ok) return false;
+    //Units that did not come through learning (e.g. probing) are only
+    //looked for every now and then, it needs a full sweep
+    if (lastSyncConf + solver->conf.sync_every_confl < solver->sumConflicts()) {
+        if (!shareUnitData())
+            return false;
 
-    sharedData->bin_mutex.lock();
-    extend_bins_if_needed();
-    clear_set_binary_values();
-    ok = shareBinData();
-    sharedData->bin_mutex.unlock();
-    if (!ok) return false;
+        adjust_glue_limit();
+        lastSyncConf = solver->sumConflicts();
+    }
+    update_export_glue_limit();
 
-    lastSyncConf = solver->sumConflicts();
+    return syncFromOthers();
+}
 
-    return true;
+uint64_t DataSync::num_props() const
+{
+    return solver->sumPropStats.propagations + solver->propStats.propagations;
 }
 
-void DataSync::clear_set_binary_values()
+void DataSync::det_check_new_solve()
 {
-    for(size_t i = 0; i < solver->nVarsOutside()*2; i++) {
-        Lit lit1 = Lit::toLit(i);
-        lit1 = solver->map_to_with_bva(lit1);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->value(lit1) != l_Undef) {
-            sharedData->bins[i].clear();
-        }
+    const uint64_t solve_num = sharedData->det_get_solve_num();
+    if (det_solve_num != solve_num) {
+        det_solve_num = solve_num;
+        det_round = 0;
+        det_last_sync_props = num_props();
     }
 }
 
-void DataSync::extend_bins_if_needed()
+//Only exchange at the end of each round. What gets published in a round only
+//depends on the thread's own search, and nobody publishes while the others
+//read, so the exchange is the same in every run.
+bool DataSync::det_syncData()
+{
+    det_check_new_solve();
+    if (sharedData->det_must_stop(det_round)) {
+        solver->set_must_interrupt_asap();
+        return true;
+    }
+
+    if (num_props() < det_last_sync_props + solver->conf.sync_every_props) {
+        return true;
+    }
+    det_last_sync_props = num_props();
+
+    //Publish
+    if (!shareUnitData())
+        return false;
+    adjust_glue_limit();
+    sharedData->det_wait();
+    det_round++;
+    stats.detRounds++;
+
+    //Somebody finished during the round, we are done
+    if (sharedData->det_must_stop(det_round)) {
+        solver->set_must_interrupt_asap();
+        return true;
+    }
+
+    //Read, in thread order
+    update_export_glue_limit();
+    const bool ret = syncFromOthers();
+    sharedData->det_wait();
+
+    return ret;
+}
+
+void DataSync::det_finish(const lbool ret)
 {
-    assert(sharedData->bins.size() <= (solver->nVarsOutside())*2);
-    if (sharedData->bins.size() == (solver->nVarsOutside())*2)
+    if (!enabled() || !solver->conf.deterministic_sync) {
         return;
+    }
 
-    sharedData->bins.resize(solver->nVarsOutside()*2);
+    det_check_new_solve();
+    sharedData->det_finish(thread_num, det_round, ret);
 }
 
-bool DataSync::shareBinData()
+//Ask for more long clauses if the ones we got so far were used in conflict
+//analysis often enough, ask for less if they mostly just took up space
+void DataSync::adjust_glue_limit()
 {
-    uint32_t oldRecvBinData = stats.recvBinData;
-    uint32_t oldSentBinData = stats.sentBinData;
+    if (!solver->conf.share_long_glue_adapt
+        || solver->conf.share_long_max_glue == 0
+    ) {
+        return;
+    }
 
-    syncBinFromOthers();
-    syncBinToOthers();
-    size_t mem = sharedData->calc_memory_use_bins();
+    const uint32_t imported = stats.importedLongCls - last_importedLongCls;
+    const uint32_t used = stats.importedUsed - last_importedUsed;
+    last_importedLongCls = stats.importedLongCls;
+    last_importedUsed = stats.importedUsed;
+
+    const uint32_t max_glue = std::max(
+        solver->conf.share_long_glue_adapt_max
+        , solver->conf.share_long_max_glue
+    );
+    const double used_ratio = (double)used/(double)std::max<uint32_t>(imported, 1);
+    if (imported < 100 || used_ratio > 0.3) {
+        if (import_glue_limit < max_glue) {
+            import_glue_limit++;
+        }
+    } else if (used_ratio < 0.1 && import_glue_limit > 2) {
+        import_glue_limit--;
+    }
+    sharedData->wanted_glue[thread_num].store(import_glue_limit, std::memory_order_relaxed);
 
     if (solver->conf.verbosity >= 3) {
         cout
-        << "c [sync] got bins " << (stats.recvBinData - oldRecvBinData)
-        << " sent bins " << (stats.sentBinData - oldSentBinData)
-        << " mem use: " << mem/(1024*1024) << " M"
+        << "c [sync] imported longs " << imported
+        << " used " << used
+        << " new import glue limit " << import_glue_limit
         << endl;
     }
-
-    return true;
 }
 
-bool DataSync::syncBinFromOthers()
+void DataSync::update_export_glue_limit()
 {
-    for (uint32_t wsLit = 0; wsLit < sharedData->bins.size(); wsLit++) {
-        if (sharedData->bins[wsLit].data == NULL) {
+    export_glue_limit = 0;
+    for(uint32_t i = 0; i < sharedData->wanted_glue.size(); i++) {
+        if (i == thread_num)
             continue;
-        }
 
-        Lit lit1 = Lit::toLit(wsLit);
-        lit1 = solver->map_to_with_bva(lit1);
-        lit1 = solver->varReplacer->get_lit_replaced_with_outer(lit1);
-        lit1 = solver->map_outer_to_inter(lit1);
-        if (solver->varData[lit1.var()].removed != Removed::none
-            || solver->value(lit1.var()) != l_Undef
-        ) {
-            continue;
-        }
+        export_glue_limit = std::max<uint32_t>(
+            export_glue_limit
+            , sharedData->wanted_glue[i].load(std::memory_order_relaxed)
+        );
+    }
+}
 
-        vector<Lit>& bins = *sharedData->bins[wsLit].data;
-        watch_subarray ws = solver->watches[lit1.toInt()];
+bool DataSync::syncFromOthers()
+{
+    const Stats old = stats;
+    for(uint32_t i = 0; i < sharedData->rings.size(); i++) {
+        if (i == thread_num)
+            continue;
 
-        assert(syncFinish.size() > wsLit);
-        if (bins.size() > syncFinish[wsLit]
-            && !syncBinFromOthers(lit1, bins, syncFinish[wsLit], ws)
-        ) {
+        const bool ok = sharedData->rings[i]->read_new(
+            ringPos[i]
+            , tmp_recv
+            , stats.lostData
+            , [&](const vector<Lit>& lits, const uint32_t glue) -> bool {
+                return addClauseFromOthers(lits, glue);
+            }
+        );
+        if (!ok) {
             return false;
         }
     }
 
+    if (solver->conf.verbosity >= 3) {
+        cout
+        << "c [sync] got units " << (stats.recvUnitData - old.recvUnitData)
+        << " bins " << (stats.recvBinData - old.recvBinData)
+        << " longs " << (stats.recvLongData - old.recvLongData)
+        << " lost " << (stats.lostData - old.lostData)
+        << " ring mem use: " << sharedData->calc_memory_use()/(1024*1024) << " M"
+        << endl;
+    }
+
     return true;
 }
 
-bool DataSync::syncBinFromOthers(
-    const Lit lit
-    , const vector<Lit>& bins
-    , uint32_t& finished
-    , watch_subarray ws
-) {
-    assert(solver->varReplacer->get_lit_replaced_with(lit) == lit);
-    assert(solver->varData[lit.var()].removed == Removed::none);
-
-    assert(toClear.empty());
+bool DataSync::bin_already_present(const Lit lit1, const Lit lit2) const
+{
+    watch_subarray_const ws = solver->watches[lit1.toInt()];
     for (const Watched& w: ws) {
-        if (w.isBin()) {
-            toClear.push_back(w.lit2());
-            assert(seen.size() > w.lit2().toInt());
-            seen[w.lit2().toInt()] = true;
+        if (w.isBin() && w.lit2() == lit2) {
+            return true;
         }
     }
 
-    vector<Lit> lits(2);
-    for (uint32_t i = finished; i < bins.size(); i++) {
-        Lit otherLit = bins[i];
-        otherLit = solver->map_to_with_bva(otherLit);
-        otherLit = solver->varReplacer->get_lit_replaced_with_outer(otherLit);
-        otherLit = solver->map_outer_to_inter(otherLit);
-        if (solver->varData[otherLit.var()].removed != Removed::none
-            || solver->value(otherLit) != l_Undef
-        ) {
-            continue;
-        }
-        assert(seen.size() > otherLit.toInt());
-        if (!seen[otherLit.toInt()]) {
-            stats.recvBinData++;
-            lits[0] = lit;
-            lits[1] = otherLit;
+    return false;
+}
 
-            //Don't add DRUP: it would add to the thread data, too
-            solver->add_clause_int(lits, true, ClauseStats(), true, NULL, false);
-            if (!solver->ok) {
-                goto end;
-            }
-        }
+bool DataSync::addClauseFromOthers(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (lits.size() >= 3 && glue > import_glue_limit) {
+        stats.filteredLongData++;
+        return true;
     }
-    finished = bins.size();
 
-    end:
-    for (const Lit l: toClear) {
-        seen[l.toInt()] = false;
+    tmp_recv_inter.clear();
+    bool all_set = true;
+    for(Lit lit: lits) {
+        assert(lit.var() < solver->nVarsOutside());
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varDataCold[lit.var()].removed != Removed::none) {
+            return true;
+        }
+        if (solver->value(lit) == l_True) {
+            return true;
+        }
+        all_set &= (solver->value(lit) != l_Undef);
+        tmp_recv_inter.push_back(lit);
     }
-    toClear.clear();
 
-    return solver->ok;
-}
-
-void DataSync::syncBinToOthers()
-{
-    for(const std::pair<Lit, Lit>& bin: newBinClauses) {
-        addOneBinToOthers(bin.first, bin.second);
-    }
+    switch(lits.size()) {
+        case 1:
+            unitShared[lits[0].var()] = true;
+            if (!all_set) {
+                stats.recvUnitData++;
+            }
+            break;
 
-    newBinClauses.clear();
-}
+        case 2:
+            if (bin_already_present(tmp_recv_inter[0], tmp_recv_inter[1])) {
+                return true;
+            }
+            stats.recvBinData++;
+            break;
 
-void DataSync::addOneBinToOthers(Lit lit1, Lit lit2)
-{
-    assert(lit1 < lit2);
-    if (sharedData->bins[lit1.toInt()].data == NULL) {
-        return;
+        default:
+            stats.recvLongData++;
+            break;
     }
 
-    vector<Lit>& bins = *sharedData->bins[lit1.toInt()].data;
-    for (const Lit lit : bins) {
-        if (lit == lit2)
-            return;
+    //Don't add DRUP: it would add to the thread data, too
+    ClauseStats cl_stats;
+    cl_stats.glue = glue;
+    cl_stats.imported = true;
+    solver->update_red_tier(cl_stats);
+    Clause* cl = solver->add_clause_int(tmp_recv_inter, true, cl_stats, true, NULL, false);
+    if (cl) {
+        solver->longRedCls.push_back(solver->cl_alloc.get_offset(cl));
+        stats.importedLongCls++;
     }
 
-    bins.push_back(lit2);
-    stats.sentBinData++;
+    return solver->okay();
 }
 
 bool DataSync::shareUnitData()
 {
-    uint32_t thisGotUnitData = 0;
     uint32_t thisSentUnitData = 0;
-
-    SharedData& shared = *sharedData;
-    if (shared.value.size() < solver->nVarsOutside()) {
-        shared.value.resize(solver->nVarsOutside(), l_Undef);
-    }
+    vector<Lit> lits(1);
+    ClauseRing& ring = *sharedData->rings[thread_num];
     for (uint32_t var = 0; var < solver->nVarsOutside(); var++) {
+        if (unitShared[var])
+            continue;
+
         Lit thisLit = Lit(var, false);
         thisLit = solver->map_to_with_bva(thisLit);
         thisLit = solver->varReplacer->get_lit_replaced_with_outer(thisLit);
         thisLit = solver->map_outer_to_inter(thisLit);
         const lbool thisVal = solver->value(thisLit);
-        const lbool otherVal = shared.value[var];
-
-        if (thisVal == l_Undef && otherVal == l_Undef)
+        if (thisVal == l_Undef)
             continue;
 
-        if (thisVal != l_Undef && otherVal != l_Undef) {
-            if (thisVal != otherVal) {
-                solver->ok = false;
-                return false;
-            } else {
-                continue;
-            }
-        }
+        lits[0] = Lit(var, thisVal == l_False);
+        ring.push(lits, 1);
+        unitShared[var] = true;
+        thisSentUnitData++;
+    }
 
-        if (otherVal != l_Undef) {
-            assert(thisVal == l_Undef);
-            Lit litToEnqueue = thisLit ^ (otherVal == l_False);
-            if (solver->varData[litToEnqueue.var()].removed != Removed::none) {
-                continue;
-            }
+    if (solver->conf.verbosity >= 3) {
+        cout
+        << "c [sync] sent units " << thisSentUnitData
+        << endl;
+    }
+    stats.sentUnitData += thisSentUnitData;
 
-            solver->enqueue(litToEnqueue);
-            solver->ok = solver->propagate<false>().isNULL();
-            if (!solver->ok)
-                return false;
+    return true;
+}
 
-            thisGotUnitData++;
-            continue;
-        }
+//Returns FALSE if the clause cannot be expressed in outside numbering
+bool DataSync::map_to_outside(const vector<Lit>& lits)
+{
+    rebuild_bva_map_if_needed();
 
-        if (thisVal != l_Undef) {
-            assert(otherVal == l_Undef);
-            shared.value[var] = thisVal;
-            thisSentUnitData++;
-            continue;
-        }
+    tmp_send.clear();
+    for(const Lit lit: lits) {
+        if (solver->varDataCold[lit.var()].is_bva)
+            return false;
+
+        const Lit outer = solver->map_inter_to_outer(lit);
+        tmp_send.push_back(map_outside_without_bva(outer));
     }
 
-    if (solver->conf.verbosity >= 3
-        //&& (thisGotUnitData > 0 || thisSentUnitData > 0)
-    ) {
-        cout
-        << "c [sync] got units " << thisGotUnitData
-        << " sent units " << thisSentUnitData
-        << endl;
+    return true;
+}
+
+void DataSync::signalNewUnitClause(const Lit lit)
+{
+    if (!enabled()) {
+        return;
     }
 
-    stats.recvUnitData += thisGotUnitData;
-    stats.sentUnitData += thisSentUnitData;
+    tmp_inter.clear();
+    tmp_inter.push_back(lit);
+    if (!map_to_outside(tmp_inter))
+        return;
 
-    return true;
+    const Var var = tmp_send[0].var();
+    if (unitShared[var])
+        return;
+
+    unitShared[var] = true;
+    sharedData->rings[thread_num]->push(tmp_send, 1);
+    stats.sentUnitData++;
 }
 
 void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
@@ -333,23 +405,67 @@ void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
         return;
     }
 
-    if (must_rebuild_bva_map) {
-        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
-        must_rebuild_bva_map = false;
+    tmp_inter.clear();
+    tmp_inter.push_back(lit1);
+    tmp_inter.push_back(lit2);
+    if (!map_to_outside(tmp_inter))
+        return;
+
+    sharedData->rings[thread_num]->push(tmp_send, 2);
+    stats.sentBinData++;
+}
+
+void DataSync::signalNewLongClause(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (!enabled()
+        || glue > export_glue_limit
+        || lits.size() > ClauseRing::max_cl_size
+    ) {
+        return;
     }
 
-    if (solver->varData[lit1.var()].is_bva)
+    if (!map_to_outside(lits))
         return;
-    if (solver->varData[lit2.var()].is_bva)
+
+    sharedData->rings[thread_num]->push(tmp_send, glue);
+    stats.sentLongData++;
+}
+
+void DataSync::signalNewLearnt(const vector<Lit>& lits, const uint32_t glue)
+{
+    const LearntCallback& callback = solver->learnt_callback;
+    if (callback.func == NULL
+        || lits.size() > callback.max_size
+        || glue > callback.max_glue
+    ) {
         return;
+    }
 
-    lit1 = solver->map_inter_to_outer(lit1);
-    lit1 = map_outside_without_bva(lit1);
-    lit2 = solver->map_inter_to_outer(lit2);
-    lit2 = map_outside_without_bva(lit2);
+    if (!map_to_outside(lits))
+        return;
 
-    if (lit1.toInt() > lit2.toInt()) {
-        std::swap(lit1, lit2);
+    if (callback.mu) {
+        std::lock_guard<std::mutex> lock(*callback.mu);
+        callback.func(callback.state, tmp_send, glue);
+    } else {
+        callback.func(callback.state, tmp_send, glue);
     }
-    newBinClauses.push_back(std::make_pair(lit1, lit2));
+}
+
+void DataSync::Stats::print() const
+{
+    cout << "c -------- SYNC STATS --------" << endl;
+    print_stats_line("c units sent", sentUnitData, recvUnitData, "received");
+    print_stats_line("c bins sent", sentBinData, recvBinData, "received");
+    print_stats_line("c longs sent", sentLongData, recvLongData, "received");
+    print_stats_line("c longs over glue limit", filteredLongData);
+    print_stats_line("c imported longs used"
+        , importedUsed
+        , stats_line_percent(importedUsed, importedLongCls)
+        , "% of imported"
+    );
+    print_stats_line("c uses of imported longs", importedUses);
+    print_stats_line("c lost to ring overflow", lostData);
+    print_stats_line("c deterministic rounds", detRounds);
+    cout << "c -------- SYNC STATS END --------" << endl;
 }
@@ -22,6 +22,7 @@
 #include "solvertypes.h"
 #include "watched.h"
 #include "watcharray.h"
+#include "clause.h"
 
 namespace CMSat {
 
@@ -30,7 +31,7 @@ class Solver;
 class DataSync
 {
     public:
-        DataSync(Solver* solver, SharedData* sharedData);
+        DataSync(Solver* solver, SharedData* sharedData, uint32_t thread_num = 0);
         bool enabled();
         void new_var(const bool bva);
         void new_vars(const size_t n);
@@ -44,42 +45,74 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signalNewUnitClause(Lit lit);
+        void signalNewLongClause(const vector<Lit>& lits, uint32_t glue);
+        void signalNewLearnt(const vector<Lit>& lits, uint32_t glue);
+        void imported_clause_used(ClauseStats& cl_stats);
+        void det_finish(const lbool ret);
 
         struct Stats
         {
+            void print() const;
+
             uint32_t sentUnitData = 0;
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint32_t sentLongData = 0;
+            uint32_t recvLongData = 0;
+            uint64_t lostData = 0;
+            uint64_t detRounds = 0; ///<Rounds ended at a barrier in deterministic mode
+
+            //Usefulness of imported long clauses
+            uint32_t filteredLongData = 0; ///<Above our own glue limit
+            uint32_t importedLongCls = 0; ///<Ended up as a long clause in our DB
+            uint32_t importedUsed = 0; ///<Out of the above, used at least once in conflict analysis
+            uint64_t importedUses = 0;
         };
         const Stats& get_stats() const;
 
     private:
-        void extend_bins_if_needed();
+        void rebuild_bva_map_if_needed();
+        bool map_to_outside(const vector<Lit>& lits);
         Lit map_outside_without_bva(Lit lit) const;
         bool shareUnitData();
-        bool syncBinFromOthers();
-        bool syncBinFromOthers(const Lit lit, const vector<Lit>& bins, uint32_t& finished, watch_subarray ws);
-        void syncBinToOthers();
-        void clear_set_binary_values();
-        void addOneBinToOthers(const Lit lit1, const Lit lit2);
-        bool shareBinData();
-
-        //stuff to sync
-        vector<std::pair<Lit, Lit> > newBinClauses;
+        bool syncFromOthers();
+        bool addClauseFromOthers(const vector<Lit>& lits, uint32_t glue);
+        bool bin_already_present(const Lit lit1, const Lit lit2) const;
+        void adjust_glue_limit();
+        void update_export_glue_limit();
+        bool det_syncData();
+        void det_check_new_solve();
+        uint64_t num_props() const;
 
         //stats
         uint64_t lastSyncConf = 0;
-        vector<uint32_t> syncFinish;
         Stats stats;
 
         //Other systems
         Solver* solver;
         SharedData* sharedData;
 
+        //lock-free sharing
+        uint32_t thread_num;
+        vector<uint64_t> ringPos; ///<Read position in other threads' rings
+        vector<char> unitShared; ///<Unit on var (outside numbering) already sent or received
+        uint32_t import_glue_limit = 0;
+        uint32_t export_glue_limit = 0; ///<Max of what the other threads want
+        uint32_t last_importedLongCls = 0;
+        uint32_t last_importedUsed = 0;
+
+        //deterministic mode
+        uint64_t det_solve_num = 0;
+        uint64_t det_round = 0;
+        uint64_t det_last_sync_props = 0;
+        vector<Lit> tmp_inter;
+        vector<Lit> tmp_send;
+        vector<Lit> tmp_recv;
+        vector<Lit> tmp_recv_inter;
+
         //misc
-        vector<uint16_t>& seen;
-        vector<Lit>& toClear;
         vector<uint32_t> outer_to_without_bva_map;
         bool must_rebuild_bva_map = false;
 };
@@ -99,6 +132,15 @@ inline void DataSync::signalNewBinClause(T& ps)
     signalNewBinClause(ps[0], ps[1]);
 }
 
+inline void DataSync::imported_clause_used(ClauseStats& cl_stats)
+{
+    stats.importedUses++;
+    if (!cl_stats.import_used) {
+        cl_stats.import_used = true;
+        stats.importedUsed++;
+    }
+}
+
 inline Lit DataSync::map_outside_without_bva(const Lit lit) const
 {
     return Lit(outer_to_without_bva_map[lit.var()], lit.sign());
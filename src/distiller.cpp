@@ -76,6 +76,28 @@ end:
     return solver->ok;
 }
 
+/**
+@brief Vivifies the best redundant clauses, called during search
+
+Only the clauses in the core and tier2 tiers are worth it: the local ones are
+likely to be thrown away at the next cleaning anyway.
+*/
+bool Distiller::distill_red_cls()
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+
+    distill_long_red_cls();
+
+    globalRedStats += runStats;
+    if (solver->conf.verbosity >= 3) {
+        runStats.print(solver->nVars());
+    }
+    runStats.clear();
+
+    return solver->ok;
+}
+
 bool Distiller::distill_tri_irred_cls()
 {
     if (solver->conf.verbosity >= 6) {
@@ -106,6 +128,7 @@ bool Distiller::distill_tri_irred_cls()
         ; upI = (upI +1) % solver->watches.size(), numDone++
 
     ) {
+        solver->poll_terminate_callback(solver->propStats.bogoProps-oldBogoProps + extraTime);
         if (solver->propStats.bogoProps-oldBogoProps + extraTime > maxNumProps
             || solver->must_interrupt_asap()
         ) {
@@ -247,6 +270,7 @@ bool Distiller::distill_long_irred_cls()
         }
 
         //if done enough, stop doing it
+        solver->poll_terminate_callback(solver->propStats.bogoProps-oldBogoProps + extraTime);
         if (solver->propStats.bogoProps-oldBogoProps + extraTime >= maxNumProps
             || solver->must_interrupt_asap()
         ) {
@@ -338,6 +362,129 @@ bool Distiller::distill_long_irred_cls()
     return solver->ok;
 }
 
+bool Distiller::distill_long_red_cls()
+{
+    assert(solver->ok);
+    if (solver->conf.verbosity >= 6) {
+        cout
+        << "c Doing distillation branch for long red clauses"
+        << endl;
+    }
+
+    double myTime = cpuTime();
+    const size_t origTrailSize = solver->trail_size();
+
+    //Time-limiting
+    uint64_t maxNumProps =
+        solver->conf.distill_red_cls_time_limitM*1000LL*1000ULL
+        *solver->conf.global_timeout_multiplier;
+
+    extraTime = 0;
+    uint64_t oldBogoProps = solver->propStats.bogoProps;
+    bool time_out = false;
+    runStats.potentialClauses = solver->longRedCls.size();
+    runStats.numCalled = 1;
+
+    //Core first, then tier2. Local clauses are not worth it, they are left
+    //at the end and not looked at
+    const ClauseAllocator& cl_alloc = solver->cl_alloc;
+    vector<ClOffset>::iterator end = std::partition(
+        solver->longRedCls.begin(), solver->longRedCls.end()
+        , [&](const ClOffset offs) {
+            return cl_alloc.ptr(offs)->stats.which_red_array == red_core;
+        }
+    );
+    end = std::partition(end, solver->longRedCls.end()
+        , [&](const ClOffset offs) {
+            return cl_alloc.ptr(offs)->stats.which_red_array == red_tier2;
+        }
+    );
+    extraTime += solver->longRedCls.size();
+
+    vector<ClOffset>::iterator i, j;
+    i = j = solver->longRedCls.begin();
+    for (; i != end; i++) {
+        //The rest is only copied over below
+        if (time_out || !solver->ok) {
+            break;
+        }
+
+        //if done enough, stop doing it
+        solver->poll_terminate_callback(solver->propStats.bogoProps-oldBogoProps + extraTime);
+        if (solver->propStats.bogoProps-oldBogoProps + extraTime >= maxNumProps
+            || solver->must_interrupt_asap()
+        ) {
+            runStats.timeOut++;
+            time_out = true;
+        }
+
+        ClOffset offset = *i;
+        Clause& cl = *solver->cl_alloc.ptr(offset);
+        extraTime += 5;
+
+        if (cl.getdistilled()) {
+            *j++ = *i;
+            continue;
+        } else {
+            cl.set_distilled(true);
+        }
+
+        extraTime += cl.size();
+        runStats.checkedClauses++;
+
+        assert(cl.size() > 3);
+        assert(cl.red());
+
+        uselessLits.clear();
+        lits.resize(cl.size());
+        std::copy(cl.begin(), cl.end(), lits.begin());
+
+        ClOffset offset2 = try_distill_clause_and_return_new(
+            offset
+            , cl.red()
+            , 1
+        );
+
+        if (offset2 != CL_OFFSET_MAX) {
+            *j++ = offset2;
+        }
+    }
+    j = std::copy(i, solver->longRedCls.end(), j);
+    solver->longRedCls.resize(j - solver->longRedCls.begin());
+
+    //Went through all of core and tier2, start again next time
+    if (!time_out) {
+        for (ClOffset offs: solver->longRedCls) {
+            solver->cl_alloc.ptr(offs)->set_distilled(false);
+        }
+    }
+
+    const double time_used = cpuTime() - myTime;
+    const double time_remain = calc_percentage(solver->propStats.bogoProps-oldBogoProps + extraTime, maxNumProps);
+    if (solver->conf.verbosity >= 2) {
+        cout << "c [distill] longred"
+        << " tried: " << runStats.checkedClauses << "/" << solver->longRedCls.size()
+        << " cl-r:" << runStats.numClShorten
+        << " lit-r:" << runStats.numLitsRem
+        << solver->conf.print_times(time_used, time_out, time_remain)
+        << endl;
+    }
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "distill long red"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+
+    runStats.time_used = cpuTime() - myTime;
+    runStats.zeroDepthAssigns = solver->trail_size() - origTrailSize;
+
+    return solver->ok;
+}
+
 ClOffset Distiller::try_distill_clause_and_return_new(
     ClOffset offset
     , const bool red
@@ -391,8 +538,21 @@ ClOffset Distiller::try_distill_clause_and_return_new(
             remove(lits, uselessLits[i2]);
         }
 
-        //Make new clause
-        Clause *cl2 = solver->add_clause_int(lits, red);
+        if (red && offset != CL_OFFSET_MAX && lits.size() > 3) {
+            if (shorten_red_clause_in_place(offset)) {
+                runStats.numLitsRem += origSize - lits.size();
+                return offset;
+            }
+        }
+
+        //Make new clause, red clauses keep their stats
+        ClauseStats stats;
+        if (red && offset != CL_OFFSET_MAX) {
+            stats = solver->cl_alloc.ptr(offset)->stats;
+            stats.glue = std::min<uint32_t>(stats.glue, lits.size());
+            solver->update_red_tier(stats);
+        }
+        Clause *cl2 = solver->add_clause_int(lits, red, stats);
 
         //Print results
         if (solver->conf.verbosity >= 5) {
@@ -435,6 +595,38 @@ ClOffset Distiller::try_distill_clause_and_return_new(
     }
 }
 
+/**
+@brief Writes the shortened 'lits' over the red clause at 'offset'
+
+The clause keeps its place in the allocator and in longRedCls, so there is no
+new allocation and nothing to free. It's only done when no literal is set at
+level 0, otherwise add_clause_int() has to clean the clause.
+*/
+bool Distiller::shorten_red_clause_in_place(const ClOffset offset)
+{
+    for (const Lit lit: lits) {
+        if (solver->value(lit) != l_Undef) {
+            return false;
+        }
+    }
+
+    Clause& cl = *solver->cl_alloc.ptr(offset);
+    assert(cl.red());
+    assert(lits.size() < cl.size());
+
+    //The new clause must be in DRUP before the old one is deleted
+    *solver->drup << lits << fin;
+    solver->detachClause(offset);
+    std::copy(lits.begin(), lits.end(), cl.begin());
+    cl.resize(lits.size());
+    cl.stats.glue = std::min<uint32_t>(cl.stats.glue, cl.size());
+    solver->update_red_tier(cl.stats);
+    solver->attachClause(cl);
+    runStats.numInPlace++;
+
+    return true;
+}
+
 Distiller::Stats& Distiller::Stats::operator+=(const Stats& other)
 {
     time_used += other.time_used;
@@ -445,6 +637,7 @@ Distiller::Stats& Distiller::Stats::operator+=(const Stats& other)
     checkedClauses += other.checkedClauses;
     potentialClauses += other.potentialClauses;
     numCalled += other.numCalled;
+    numInPlace += other.numInPlace;
 
     return *this;
 }
@@ -485,6 +678,11 @@ void Distiller::Stats::print(const size_t nVars) const
     print_stats_line("c lits-rem",
         numLitsRem
     );
+    print_stats_line("c shortened in place"
+        , numInPlace
+        , stats_line_percent(numInPlace, numClShorten)
+        , "% of shortened"
+    );
     print_stats_line("c 0-depth-assigns",
         zeroDepthAssigns
         , stats_line_percent(zeroDepthAssigns, nVars)
@@ -40,6 +40,7 @@ class Distiller {
     public:
         Distiller(Solver* solver);
         bool distill(bool alsoStrengthen);
+        bool distill_red_cls();
 
         struct Stats
         {
@@ -61,9 +62,11 @@ class Distiller {
             uint64_t checkedClauses = 0;
             uint64_t potentialClauses = 0;
             uint64_t numCalled = 0;
+            uint64_t numInPlace = 0; ///<Red clauses shortened without reallocating
         };
 
         const Stats& get_stats() const;
+        const Stats& get_red_stats() const;
 
     private:
 
@@ -72,9 +75,11 @@ class Distiller {
             , const bool red
             , const uint32_t queueByBy
         );
+        bool shorten_red_clause_in_place(const ClOffset offset);
 
         //Actual algorithms used
         bool distill_long_irred_cls();
+        bool distill_long_red_cls();
         bool distill_tri_irred_cls();
         Solver* solver;
 
@@ -86,6 +91,7 @@ class Distiller {
         //Global status
         Stats runStats;
         Stats globalStats;
+        Stats globalRedStats;
         size_t numCalls = 0;
 
 };
@@ -95,6 +101,11 @@ inline const Distiller::Stats& Distiller::get_stats() const
     return globalStats;
 }
 
+inline const Distiller::Stats& Distiller::get_red_stats() const
+{
+    return globalRedStats;
+}
+
 } //end namespace
 
 #endif //__DISTILLER_H__
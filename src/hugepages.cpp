@@ -0,0 +1,165 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "hugepages.h"
+#include "solvertypes.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace CMSat;
+using std::string;
+
+void* HugePages::map(const size_t bytes, const bool huge, const bool noreserve)
+{
+    #if defined(__linux__)
+    //Map one huge page more, then cut off the unaligned ends
+    const size_t mapped = bytes + huge_page_size;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    if (noreserve) {
+        flags |= MAP_NORESERVE;
+    }
+    void* mem = mmap(NULL, mapped, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (mem == MAP_FAILED) {
+        return NULL;
+    }
+
+    const size_t start = (size_t)mem;
+    const size_t aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+    if (aligned > start) {
+        munmap(mem, aligned - start);
+    }
+    const size_t tail = start + mapped - (aligned + bytes);
+    if (tail > 0) {
+        munmap((void*)(aligned + bytes), tail);
+    }
+
+    if (huge) {
+        advise((void*)aligned, bytes);
+    }
+
+    return (void*)aligned;
+    #else
+    return NULL;
+    #endif
+}
+
+void HugePages::unmap(void* mem, const size_t bytes)
+{
+    #if defined(__linux__)
+    munmap(mem, bytes);
+    #endif
+}
+
+void HugePages::advise(void* mem, const size_t bytes)
+{
+    #if defined(__linux__) && defined(MADV_HUGEPAGE)
+    madvise(mem, bytes, MADV_HUGEPAGE);
+    #endif
+}
+
+void HugePages::release(void* mem, const size_t bytes)
+{
+    #if defined(__linux__)
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t start = ((size_t)mem + page_size - 1) & ~(page_size - 1);
+    const size_t end = ((size_t)mem + bytes) & ~(page_size - 1);
+    if (start < end) {
+        madvise((void*)start, end - start, MADV_DONTNEED);
+    }
+    #endif
+}
+
+uint64_t HugePages::PageStats::tlb_entries() const
+{
+    #if defined(__linux__)
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    #else
+    const size_t page_size = 4096;
+    #endif
+    return (resident - huge)/page_size + huge/huge_page_size;
+}
+
+void HugePages::PageStats::print(const string& name) const
+{
+    if (resident == 0) {
+        return;
+    }
+
+    print_stats_line("c Huge page mem " + name
+        , huge/(1024UL*1024UL)
+        , "MB"
+        , stats_line_percent(huge, resident)
+        , "% of resident"
+    );
+    print_stats_line("c TLB entries " + name
+        , tlb_entries()
+        , "pages"
+    );
+}
+
+static uint64_t read_kb(const string& line)
+{
+    std::stringstream ss(line.substr(line.find(':') + 1));
+    uint64_t kb = 0;
+    ss >> kb;
+    return kb*1024;
+}
+
+void HugePages::count_pages(const void* start, const size_t bytes, PageStats& stats)
+{
+    #if defined(__linux__)
+    if (start == NULL || bytes == 0) {
+        return;
+    }
+
+    std::ifstream file("/proc/self/smaps");
+    const size_t from = (size_t)start;
+    const size_t to = from + bytes;
+    bool overlaps = false;
+    string line;
+    while(std::getline(file, line)) {
+        //Mapping headers start with the address range, fields with a name
+        const size_t dash = line.find('-');
+        const size_t colon = line.find(':');
+        if (dash != string::npos && (colon == string::npos || dash < colon)) {
+            const size_t map_from = std::stoull(line.substr(0, dash), NULL, 16);
+            const size_t map_to = std::stoull(line.substr(dash+1), NULL, 16);
+            overlaps = map_from < to && from < map_to;
+            continue;
+        }
+        if (!overlaps) {
+            continue;
+        }
+
+        if (line.compare(0, 4, "Rss:") == 0) {
+            stats.resident += read_kb(line);
+        } else if (line.compare(0, 14, "AnonHugePages:") == 0) {
+            stats.huge += read_kb(line);
+        }
+    }
+    #endif
+}
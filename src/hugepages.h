@@ -0,0 +1,85 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2015, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __HUGEPAGES_H__
+#define __HUGEPAGES_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+namespace CMSat {
+
+/**
+@brief Maps large, long-lived arrays so they can be backed by huge pages
+
+Propagation on big instances touches the clause arena and the watchlists all
+over, so the TLB misses more than the data caches. A 2MB page needs one TLB
+entry where 4KB pages need 512. The mappings are aligned to 2MB and, if asked
+for, marked with MADV_HUGEPAGE so transparent huge pages back them. hugetlbfs
+is not used: a mapping of it fails, or faults later, when the preallocated pool
+is too small. On systems other than Linux map() fails, and the callers fall
+back to malloc.
+*/
+class HugePages
+{
+    public:
+        static const size_t huge_page_size = 2UL*1024UL*1024UL;
+
+        //Zeroed memory of 'bytes' bytes aligned to huge_page_size. NULL if it failed.
+        //With 'noreserve', memory is only committed as it is written.
+        static void* map(const size_t bytes, const bool huge, const bool noreserve);
+        static void unmap(void* mem, const size_t bytes);
+
+        //Asks for huge pages for [mem, mem+bytes) of a mapping from map()
+        static void advise(void* mem, const size_t bytes);
+
+        //Gives back the whole pages of [mem, mem+bytes) to the OS. In anonymous
+        //mappings they read as zeroes the next time. In a private mapping of a
+        //file, only the pages copied on write are freed, and the pages read
+        //as the file's contents again.
+        static void release(void* mem, const size_t bytes);
+
+        struct PageStats
+        {
+            uint64_t resident = 0; ///<Bytes in memory
+            uint64_t huge = 0; ///<Bytes of those on huge pages
+
+            //The number of TLB entries needed to reach all of the memory
+            uint64_t tlb_entries() const;
+
+            PageStats& operator+=(const PageStats& other)
+            {
+                resident += other.resident;
+                huge += other.huge;
+                return *this;
+            }
+
+            void print(const std::string& name) const;
+        };
+
+        //Counts the mappings that overlap [start, start+bytes), from /proc/self/smaps
+        static void count_pages(const void* start, const size_t bytes, PageStats& stats);
+};
+
+}
+
+#endif //__HUGEPAGES_H__
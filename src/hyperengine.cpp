@@ -601,17 +601,17 @@ Lit HyperEngine::remove_which_bin_due_to_trans_red(
     bool second_is_deeper = false;
     bool ambivalent = true;
     if (use_depth_trick) {
-        ambivalent = varData[thisAncestor.var()].depth == varData[lookingForAncestor.var()].depth;
-        if (varData[thisAncestor.var()].depth < varData[lookingForAncestor.var()].depth) {
+        ambivalent = varDataCold[thisAncestor.var()].depth == varDataCold[lookingForAncestor.var()].depth;
+        if (varDataCold[thisAncestor.var()].depth < varDataCold[lookingForAncestor.var()].depth) {
             second_is_deeper = true;
         }
     }
     #ifdef DEBUG_DEPTH
     cout
     << "1st: " << std::setw(6) << thisAncestor
-    << " depth: " << std::setw(4) << varData[thisAncestor.var()].depth
+    << " depth: " << std::setw(4) << varDataCold[thisAncestor.var()].depth
     << "  2nd: " << std::setw(6) << lookingForAncestor
-    << " depth: " << std::setw(4) << varData[lookingForAncestor.var()].depth
+    << " depth: " << std::setw(4) << varDataCold[lookingForAncestor.var()].depth
     ;
     #endif
 
@@ -707,10 +707,10 @@ bool HyperEngine::is_ancestor_of(
     }
 
     //This is as low as we should search -- we cannot find what we are searchig for lower than this
-    const size_t bottom = varData[lookingForAncestor.var()].depth;
+    const size_t bottom = varDataCold[lookingForAncestor.var()].depth;
 
     while(thisAncestor != lit_Undef
-        && (!use_depth_trick || bottom <= varData[thisAncestor.var()].depth)
+        && (!use_depth_trick || bottom <= varDataCold[thisAncestor.var()].depth)
     ) {
         #ifdef VERBOSE_DEBUG_FULLPROP
         cout << "Current acestor: " << thisAncestor
@@ -1024,7 +1024,7 @@ PropResult HyperEngine::prop_bin_with_ancestor_info(
             //Update data indicating what lead to lit
             varData[lit.var()].reason = PropBy(~p, k->red(), false, false);
             assert(varData[p.var()].level != 0);
-            varData[lit.var()].depth = varData[p.var()].depth + 1;
+            varDataCold[lit.var()].depth = varDataCold[p.var()].depth + 1;
             //NOTE: we don't update the levels of other literals... :S
 
             //for correctness, we would need this, but that would need re-writing of history :S
@@ -1180,16 +1180,16 @@ void HyperEngine::enqueue_with_acestor_info(
     assert(varData[ancestor.var()].level != 0);
 
     if (use_depth_trick) {
-        varData[p.var()].depth = varData[ancestor.var()].depth + 1;
+        varDataCold[p.var()].depth = varDataCold[ancestor.var()].depth + 1;
     } else {
-        varData[p.var()].depth = 0;
+        varDataCold[p.var()].depth = 0;
     }
     #if defined(DEBUG_DEPTH) || defined(VERBOSE_DEBUG_FULLPROP)
     cout
     << "Enqueued "
     << std::setw(6) << (p)
     << " by " << std::setw(6) << (~ancestor)
-    << " at depth " << std::setw(4) << varData[p.var()].depth
+    << " at depth " << std::setw(4) << varDataCold[p.var()].depth
     << " at dec level: " << decisionLevel()
     << endl;
     #endif
@@ -84,7 +84,7 @@ void ImplCache::print_statsSort(const Solver* solver) const
     for(size_t i = 0; i < implCache.size(); i++) {
         Lit lit = Lit::toLit(i);
 
-        if (solver->varData[lit.var()].removed == Removed::none) {
+        if (solver->varDataCold[lit.var()].removed == Removed::none) {
             activeLits++;
             totalElems += implCache[i].lits.size();
             numHasElems += !implCache[i].lits.empty();
@@ -119,7 +119,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
     for (Var var = 0; var < solver->nVars(); var++) {
 
         //If replaced, merge it into the one that replaced it
-        if (solver->varData[var].removed == Removed::replaced) {
+        if (solver->varDataCold[var].removed == Removed::replaced) {
             for(int i = 0; i < 2; i++) {
                 const Lit litOrig = Lit(var, i);
                 if (implCache[litOrig.toInt()].lits.empty())
@@ -129,7 +129,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
 
                 //Updated literal must be normal, otherwise, biig problems e.g
                 //implCache is not even large enough, etc.
-                if (solver->varData[lit.var()].removed == Removed::none) {
+                if (solver->varDataCold[lit.var()].removed == Removed::none) {
                     bool taut = implCache.at(lit.toInt()).merge(
                         implCache[litOrig.toInt()].lits
                         , lit_Undef //nothing to add
@@ -148,9 +148,9 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
 
         //Free it
         if (solver->value(var) != l_Undef
-            || solver->varData[var].removed == Removed::elimed
-            || solver->varData[var].removed == Removed::replaced
-            || solver->varData[var].removed == Removed::decomposed
+            || solver->varDataCold[var].removed == Removed::elimed
+            || solver->varDataCold[var].removed == Removed::replaced
+            || solver->varDataCold[var].removed == Removed::decomposed
         ) {
             vector<LitExtra> tmp1;
             numFreed += implCache[Lit(var, false).toInt()].lits.capacity();
@@ -189,7 +189,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
                 continue;
 
             //Update to its replaced version
-            if (solver->varData[lit.var()].removed == Removed::replaced) {
+            if (solver->varDataCold[lit.var()].removed == Removed::replaced) {
                 lit = solver->varReplacer->get_lit_replaced_with(lit);
 
                 //This would be tautological (and incorrect), so skip
@@ -204,7 +204,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
                 continue;
 
             //If updated version is eliminated/decomposed, skip
-            if (solver->varData[lit.var()].removed != Removed::none)
+            if (solver->varDataCold[lit.var()].removed != Removed::none)
                 continue;
 
             //Mark irred
@@ -241,7 +241,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
 
             //Set non-leartness correctly
             *it2 = LitExtra(lit, nRed);
-            assert(solver->varData[it2->getLit().var()].removed == Removed::none);
+            assert(solver->varDataCold[it2->getLit().var()].removed == Removed::none);
             assert(solver->value(it2->getLit()) == l_Undef);
         }
         numCleaned += origSize-trans->lits.size();
@@ -315,7 +315,7 @@ bool ImplCache::addDelayedClauses(Solver* solver)
                 ; it2 != end2
                 ; it2++
             ) {
-                if (solver->varData[it2->var()].removed != Removed::none) {
+                if (solver->varDataCold[it2->var()].removed != Removed::none) {
                     //Var has been eliminated one way or another. Don't add this clause
                     OK = false;
                     break;
@@ -375,7 +375,7 @@ bool ImplCache::tryBoth(Solver* solver)
 
         //If value is set or eliminated, skip
         if (solver->value(var) != l_Undef
-            || solver->varData[var].removed != Removed::none
+            || solver->varDataCold[var].removed != Removed::none
         ) {
             continue;
         }
@@ -436,7 +436,7 @@ void ImplCache::tryVar(
         const Var var2 = it->getLit().var();
 
         //A variable that has been really eliminated, skip
-        if (solver->varData[var2].removed != Removed::none) {
+        if (solver->varDataCold[var2].removed != Removed::none) {
             continue;
         }
 
@@ -480,7 +480,7 @@ void ImplCache::tryVar(
             continue;
 
         //If var has been removed, skip
-        if (solver->varData[var2].removed != Removed::none) {
+        if (solver->varDataCold[var2].removed != Removed::none) {
             continue;
         }
 
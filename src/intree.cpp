@@ -106,7 +106,7 @@ void InTree::fill_roots()
     for(uint32_t i = 0; i < solver->nVars()*2; i++)
     {
         Lit lit(i/2, i%2);
-        if (solver->varData[lit.var()].removed != Removed::none
+        if (solver->varDataCold[lit.var()].removed != Removed::none
             || solver->value(lit) != l_Undef
         ) {
             continue;
@@ -263,11 +263,35 @@ void Main::add_supported_options()
     ("threads,t", po::value(&num_threads)->default_value(1)
         ,"Number of threads")
     ("sync", po::value(&conf.sync_every_confl)->default_value(conf.sync_every_confl)
-        , "Sync threads every N conflicts")
+        , "Sync units not coming from learning every N conflicts")
+    ("pin", po::value(&conf.thread_pinning)->default_value(conf.thread_pinning)
+        , "Pin threads to CPUs, so their memory stays on their NUMA node. 0 = don't pin, 1 = fill up NUMA nodes one by one, 2 = spread threads over NUMA nodes (Linux only)")
+    ("deterministic", po::value(&conf.deterministic_sync)->default_value(conf.deterministic_sync)
+        , "Threads only exchange clauses at points decided by their own propagation count, the winner is decided the same way. Multi-threaded runs become reproducible")
+    ("syncprops", po::value(&conf.sync_every_props)->default_value(conf.sync_every_props)
+        , "In deterministic mode, sync threads every N propagations")
+    ("cube", po::value(&conf.do_cube_and_conquer)->default_value(conf.do_cube_and_conquer)
+        , "Split the problem into cubes using lookahead, then let the threads solve the cubes instead of racing on the whole problem")
+    ("cubedepth", po::value(&conf.cube_depth)->default_value(conf.cube_depth)
+        , "Depth of the cube tree, i.e. max 2^N cubes. 0 = decide based on the number of threads")
+    ("cubelookvars", po::value(&conf.cube_lookahead_vars)->default_value(conf.cube_lookahead_vars)
+        , "Number of variables to look ahead on when picking the variable to split on")
+    ("sharering", po::value(&conf.share_ring_size_log2)->default_value(conf.share_ring_size_log2)
+        , "[4-24] Log2 of the number of clauses each thread can have in flight to the other threads")
+    ("shareglue", po::value(&conf.share_long_max_glue)->default_value(conf.share_long_max_glue)
+        , "Share learnt clauses of 3 or more literals with other threads if their glue is at most this")
+    ("shareglueadapt", po::value(&conf.share_long_glue_adapt)->default_value(conf.share_long_glue_adapt)
+        , "Raise or lower the glue limit of shared clauses depending on how often imported clauses are used in conflict analysis")
+    ("shareglueadaptmax", po::value(&conf.share_long_glue_adapt_max)->default_value(conf.share_long_glue_adapt_max)
+        , "Never raise the glue limit of shared clauses above this")
+    ("sharearena", po::value(&conf.share_irred_arena)->default_value(conf.share_irred_arena)
+        , "Threads share the memory of the original long clauses, copying a page only when they change it (Linux only). Propagation changes most pages soon, so this mostly saves memory while simplifying")
     ("maxtime", po::value(&conf.maxTime)->default_value(conf.maxTime, "MAX")
         , "Stop solving after this much time (s)")
     ("maxconfl", po::value(&conf.maxConfl)->default_value(conf.maxConfl, "MAX")
         , "Stop solving after this many conflicts")
+    ("terminatepoll", po::value(&conf.terminate_poll_props)->default_value(conf.terminate_poll_props)
+        , "Call the library user's terminate callback once every this many propagations, or an equivalent amount of work during simplification")
     ("mult,m", po::value(&conf.orig_global_timeout_multiplier)->default_value(conf.orig_global_timeout_multiplier)
         , "Multiplier for all simplification cutoffs")
     ("preproc,p", po::value(&conf.preprocess)->default_value(conf.preprocess)
@@ -293,6 +317,8 @@ void Main::add_supported_options()
         , "Multiplier used for blocking restart cut-off (called 'R' in Glucose 3.0)")
     ("lwrbndblkrest", po::value(&conf.lower_bound_for_blocking_restart)->default_value(conf.lower_bound_for_blocking_restart)
         , "Lower bound on blocking restart -- don't block before this many concflicts")
+    ("chrono", po::value(&conf.chrono_backtrack)->default_value(conf.chrono_backtrack)
+        , "Backtrack chronologically (one level) when the backjump would be longer than this many levels. -1 = never")
     ;
 
     std::ostringstream s_incclean;
@@ -312,6 +338,10 @@ void Main::add_supported_options()
         , "Don't ever have more than maxNumRedsRatio*(irred_clauses) redundant clauses")
     ("maxtemp", po::value(&conf.max_temporary_learnt_clauses)->default_value(conf.max_temporary_learnt_clauses)
         , "Maximum number of temporary clauses of high glue")
+    ("keepglue", po::value(&conf.glue_must_keep_clause_if_below_or_eq)->default_value(conf.glue_must_keep_clause_if_below_or_eq)
+        , "Redundant clauses with at most this glue are never removed")
+    ("tier2glue", po::value(&conf.glue_put_tier2_if_below_or_eq)->default_value(conf.glue_put_tier2_if_below_or_eq)
+        , "Redundant clauses with at most this glue are kept as long as they are used in conflict analysis between two cleanings")
     ;
 
     std::ostringstream s_random_var_freq;
@@ -511,6 +541,10 @@ void Main::add_supported_options()
         , "Time-out in microsteps for each more minimisation with binary clauses. Only active if 'moreminim' is on")
     ("moreminimlit", po::value(&conf.max_num_lits_more_red_min)->default_value(conf.max_num_lits_more_red_min)
         , "Number of first literals to look through for more minimisation when doing learnt cl minim right after learning it")
+    ("bingraphminim", po::value(&conf.doMinimRedBinGraph)->default_value(conf.doMinimRedBinGraph)
+        , "Minimise every learnt clause by walking the binary implication graph from its literals")
+    ("bingraphminimsteps", po::value(&conf.bin_graph_minim_max_steps)->default_value(conf.bin_graph_minim_max_steps)
+        , "Time-out in microsteps for each binary implication graph minimisation")
     ("cacheformoreminim", po::value(&conf.more_otf_shrink_with_stamp)->default_value(conf.more_otf_shrink_with_stamp)
         , "Use cache for otf more minim of learnt clauses")
     ("stampformoreminim", po::value(&conf.more_otf_shrink_with_cache)->default_value(conf.more_otf_shrink_with_cache)
@@ -534,6 +568,14 @@ void Main::add_supported_options()
         , "Update glues while analyzing")
     ("binpri", po::value(&conf.propBinFirst)->default_value(conf.propBinFirst)
         , "Propagated binary clauses strictly first")
+    ("binblock", po::value(&conf.doBinBlockFirst)->default_value(conf.doBinBlockFirst)
+        , "During search, move binaries to the front of each watchlist and propagate them in a separate, tight loop")
+    ("simdbins", po::value(&conf.doSIMDBinProp)->default_value(conf.doSIMDBinProp)
+        , "Look up the values of 8 binaries at the front of a watchlist at once with AVX2, if the CPU supports it")
+    ("propprefetch", po::value(&conf.doPropPrefetch)->default_value(conf.doPropPrefetch)
+        , "While propagating a literal, prefetch the watchlists of the next ones on the trail and the clauses they reference")
+    ("prefetchcls", po::value(&conf.prop_prefetch_cls)->default_value(conf.prop_prefetch_cls)
+        , "Number of long clauses to prefetch from each upcoming watchlist")
     ("otfhyper", po::value(&conf.otfHyperbin)->default_value(conf.otfHyperbin)
         , "Perform hyper-binary resolution at dec. level 1 after every restart and during probing")
     ;
@@ -606,14 +648,22 @@ void Main::add_supported_options()
         , "Maximum number of Mega-bogoprops(~time) to spend on viviying long irred cls by enqueueing and propagating")
     ("distillto", po::value(&conf.distill_time_limitM)->default_value(conf.distill_time_limitM)
         , "Maximum time in bogoprops M for distillation")
+    ("distillred", po::value(&conf.do_distill_red_clauses)->default_value(conf.do_distill_red_clauses)
+        , "Distill the core and tier2 red clauses after every clause cleaning")
+    ("distillredmaxm", po::value(&conf.distill_red_cls_time_limitM)->default_value(conf.distill_red_cls_time_limitM)
+        , "Maximum number of Mega-bogoprops(~time) to spend on vivifying long red cls after each clause cleaning")
     ("strcachemaxm", po::value(&conf.watch_cache_stamp_based_str_time_limitM)->default_value(conf.watch_cache_stamp_based_str_time_limitM)
         , "Maximum number of Mega-bogoprops(~time) to spend on viviying long irred cls through watches, cache and stamps")
     ("sortwatched", po::value(&conf.doSortWatched)->default_value(conf.doSortWatched)
         , "Sort watches according to size")
     ("renumber", po::value(&conf.doRenumberVars)->default_value(conf.doRenumberVars)
         , "Renumber variables to increase CPU cache efficiency")
+    ("renumberoccur", po::value(&conf.renumber_by_occur)->default_value(conf.renumber_by_occur)
+        , "When renumbering, number the variables in the order they occur in the irredundant clauses, so the variables of a clause are close in memory")
     ("savemem", po::value(&conf.doSaveMem)->default_value(conf.doSaveMem)
         , "Save memory by deallocating variable space after renumbering. Only works if renumbering is active.")
+    ("hugepages", po::value(&conf.huge_pages)->default_value(conf.huge_pages)
+        , "Back the clause slabs and the pooled watchlists with transparent huge pages (Linux only)")
     ("implicitmanip", po::value(&conf.doStrSubImplicit)->default_value(conf.doStrSubImplicit)
         , "Subsume and strengthen implicit clauses with each other")
     ("implsubsto", po::value(&conf.subsume_implicit_time_limitM)->default_value(conf.subsume_implicit_time_limitM)
@@ -968,6 +1018,15 @@ void Main::manually_parse_some_options()
         std::exit(-1);
     }
 
+    if (conf.thread_pinning < 0 || conf.thread_pinning > 2) {
+        std::cerr
+        << "ERROR: Thread pinning (\"--pin\") must be 0, 1 or 2, it is "
+        << conf.thread_pinning
+        << endl;
+
+        std::exit(-1);
+    }
+
     if (conf.preprocess != 0) {
         conf.varelim_time_limitM *= 3;
         conf.global_timeout_multiplier *= 1.5;
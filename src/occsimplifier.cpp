@@ -184,7 +184,7 @@ void OccSimplifier::extend_model(SolutionExtender* extender)
     //Either a variable is not eliminated, or its value is undef
     for(size_t i = 0; i < solver->nVarsOuter(); i++) {
         const Var outer = solver->map_inter_to_outer(i);
-        assert(solver->varData[i].removed != Removed::elimed
+        assert(solver->varDataCold[i].removed != Removed::elimed
             || (solver->value(i) == l_Undef && solver->model[outer] == l_Undef)
         );
     }
@@ -516,20 +516,20 @@ bool OccSimplifier::check_varelim_when_adding_back_cl(const Clause* cl) const
         //The clause was too long, and wasn't linked in
         //but has been var-elimed, so remove it
         if (!cl->getOccurLinked()
-            && solver->varData[it2->var()].removed == Removed::elimed
+            && solver->varDataCold[it2->var()].removed == Removed::elimed
         ) {
             notLinkedNeedFree = true;
         }
 
         if (cl->getOccurLinked()
-            && solver->varData[it2->var()].removed != Removed::none
+            && solver->varDataCold[it2->var()].removed != Removed::none
         ) {
             std::cerr
             << "ERROR! Clause " << *cl
             << " red: " << cl->red()
             << " contains lit " << *it2
             << " which has removed status"
-            << removed_type_to_string(solver->varData[it2->var()].removed)
+            << removed_type_to_string(solver->varDataCold[it2->var()].removed)
             << endl;
 
             assert(false);
@@ -721,7 +721,7 @@ bool OccSimplifier::can_eliminate_var(const Var var) const
 {
     assert(var <= solver->nVars());
     if (solver->value(var) != l_Undef
-        || solver->varData[var].removed != Removed::none
+        || solver->varDataCold[var].removed != Removed::none
         ||  solver->var_inside_assumptions(var)
     ) {
         return false;
@@ -757,6 +757,7 @@ bool OccSimplifier::eliminate_vars()
             && !solver->must_interrupt_asap()
         ) {
             assert(limit_to_decrease == &norm_varelim_time_limit);
+            solver->poll_terminate_callback(orig_norm_varelim_time_limit - *limit_to_decrease);
             Var var = velim_order.remove_min();
 
             //Stats
@@ -1068,7 +1069,7 @@ bool OccSimplifier::uneliminate(Var var)
     //Check that it was really eliminated
     //NOTE: it's already been made a decision var, as the variable has been re-added already
     solver->set_decision_var(var);
-    assert(solver->varData[var].removed == Removed::elimed);
+    assert(solver->varDataCold[var].removed == Removed::elimed);
     assert(solver->value(var) == l_Undef);
 
     if (!blockedMapBuilt) {
@@ -1078,7 +1079,7 @@ bool OccSimplifier::uneliminate(Var var)
 
     //Uneliminate it in theory
     globalStats.numVarsElimed--;
-    solver->varData[var].removed = Removed::none;
+    solver->varDataCold[var].removed = Removed::none;
     solver->set_decision_var(var);
 
     //Find if variable is really needed to be eliminated
@@ -1225,7 +1226,7 @@ void OccSimplifier::sanityCheckElimedVars()
             continue;
 
         for (const Lit lit: *cl) {
-            if (solver->varData[lit.var()].removed == Removed::elimed) {
+            if (solver->varDataCold[lit.var()].removed == Removed::elimed) {
                 cout
                 << "Error: elimed var -- Lit " << lit << " in clause"
                 << endl
@@ -1251,8 +1252,8 @@ void OccSimplifier::sanityCheckElimedVars()
             ; it2++
         ) {
             if (it2->isBin()) {
-                if (solver->varData[lit.var()].removed == Removed::elimed
-                        || solver->varData[it2->lit2().var()].removed == Removed::elimed
+                if (solver->varDataCold[lit.var()].removed == Removed::elimed
+                        || solver->varDataCold[it2->lit2().var()].removed == Removed::elimed
                 ) {
                     cout
                     << "Error: A var is elimed in a binary clause: "
@@ -1331,7 +1332,7 @@ void OccSimplifier::cleanBlockedClauses()
         ; i++
     ) {
         const Var blockedOn = solver->map_outer_to_inter(i->blockedOn.var());
-        if (solver->varData[blockedOn].removed == Removed::elimed
+        if (solver->varDataCold[blockedOn].removed == Removed::elimed
             && solver->value(blockedOn) != l_Undef
         ) {
             std::cerr
@@ -1345,7 +1346,7 @@ void OccSimplifier::cleanBlockedClauses()
         if (i->toRemove) {
             blockedMapBuilt = false;
         } else {
-            assert(solver->varData[blockedOn].removed == Removed::elimed);
+            assert(solver->varDataCold[blockedOn].removed == Removed::elimed);
             *j++ = *i;
         }
     }
@@ -1682,7 +1683,7 @@ bool OccSimplifier::skip_resolution_thanks_to_gate(
 int OccSimplifier::test_elim_and_fill_resolvents(const Var var)
 {
     assert(solver->ok);
-    assert(solver->varData[var].removed == Removed::none);
+    assert(solver->varDataCold[var].removed == Removed::none);
     assert(solver->value(var) == l_Undef);
 
     //Gather data
@@ -2051,8 +2052,8 @@ void OccSimplifier::set_var_as_eliminated(const Var var, const Lit lit)
         <<  solver->map_inter_to_outer(lit)
         << " finished " << endl;
     }
-    assert(solver->varData[var].removed == Removed::none);
-    solver->varData[var].removed = Removed::elimed;
+    assert(solver->varDataCold[var].removed == Removed::none);
+    solver->varDataCold[var].removed = Removed::elimed;
 
     runStats.numVarsElimed++;
 }
@@ -2720,7 +2721,7 @@ std::pair<int, int> OccSimplifier::strategyCalcVarElimScore(const Var var)
 void OccSimplifier::check_elimed_vars_are_unassigned() const
 {
     for (size_t i = 0; i < solver->nVarsOuter(); i++) {
-        if (solver->varData[i].removed == Removed::elimed) {
+        if (solver->varDataCold[i].removed == Removed::elimed) {
             assert(solver->value(i) == l_Undef);
         }
     }
@@ -2731,7 +2732,7 @@ void OccSimplifier::check_elimed_vars_are_unassignedAndStats() const
     assert(solver->ok);
     int64_t checkNumElimed = 0;
     for (size_t i = 0; i < solver->nVarsOuter(); i++) {
-        if (solver->varData[i].removed == Removed::elimed) {
+        if (solver->varDataCold[i].removed == Removed::elimed) {
             checkNumElimed++;
             assert(solver->value(i) == l_Undef);
         }
@@ -299,7 +299,7 @@ Lit Prober::update_lit_for_dominator(
         if (solver->litReachable[lit.toInt()].lit != lit_Undef) {
             const Lit betterlit = solver->litReachable[lit.toInt()].lit;
             if (solver->value(betterlit.var()) == l_Undef
-                && solver->varData[betterlit.var()].removed == Removed::none
+                && solver->varDataCold[betterlit.var()].removed == Removed::none
             ) {
                 //Update lit
                 lit = betterlit;
@@ -315,7 +315,7 @@ vector<Var> Prober::randomize_possible_choices()
     vector<Var> poss_choice;
     for(size_t i = 0; i < solver->nVars(); i++) {
         if (solver->value(i) == l_Undef
-            && solver->varData[i].removed == Removed::none
+            && solver->varDataCold[i].removed == Removed::none
         ) {
             poss_choice.push_back(i);
         }
@@ -362,6 +362,7 @@ bool Prober::probe()
     ) {
         extraTime += 20;
         runStats.numLoopIters++;
+        solver->poll_terminate_callback(limit_used());
         const Var var = poss_choice[i];
 
         //Check if already blacklisted
@@ -373,7 +374,7 @@ bool Prober::probe()
 
         //Check if var is set already
         if (solver->value(lit.var()) != l_Undef
-            || solver->varData[lit.var()].removed != Removed::none
+            || solver->varDataCold[lit.var()].removed != Removed::none
             || visitedAlready[lit.toInt()]
         ) {
             continue;
@@ -487,7 +488,7 @@ void Prober::update_cache(Lit thisLit, Lit lit, size_t numElemsSet)
         //enqueue ~ancestor at toplevel since both
         //~ancestor V OTHER, and ~ancestor V ~OTHER are technically in
         if (taut
-            && solver->varData[ancestor.var()].removed == Removed::none
+            && solver->varDataCold[ancestor.var()].removed == Removed::none
         ) {
             toEnqueue.push_back(~ancestor);
             if (solver->conf.verbosity >= 10)
@@ -628,7 +629,7 @@ bool Prober::try_this(const Lit lit, const bool first, const uint64_t orig_num_p
     runStats.numProbed++;
     solver->new_decision_level();
     solver->enqueue(lit);
-    solver->varData[lit.var()].depth = 0;
+    solver->varDataCold[lit.var()].depth = 0;
     if (solver->conf.verbosity >= 6) {
         cout
         << "c Probing lit " << lit
@@ -747,7 +748,7 @@ size_t Prober::mem_used() const
 //     while(true) {
 //         Var var = solver->negPosDist[solver->mtrand.randInt(max)].var;
 //         if (solver->value(var) != l_Undef
-//             || (solver->varData[var].removed != Removed::none)
+//             || (solver->varDataCold[var].removed != Removed::none)
 //         ) continue;
 //
 //         bool OK = true;
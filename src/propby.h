@@ -54,11 +54,12 @@ class PropBy
             , data2(0)
         {}
 
+        //The top bit of the offset is kept in data2
         explicit PropBy(const ClOffset offset) :
             red_step(0)
-            , data1(offset)
+            , data1(offset & 0x7fffffffU)
             , type(clause_t)
-            , data2(0)
+            , data2(offset >> 31)
         {
             //No roll-over
             #ifdef DEBUG_PROPAGATEFROM
@@ -185,7 +186,7 @@ class PropBy
             #ifdef DEBUG_PROPAGATEFROM
             assert(isClause());
             #endif
-            return data1;
+            return data1 | ((ClOffset)data2 << 31);
         }
 
         size_t get_xor_num() const
@@ -34,6 +34,7 @@
 #include "time_mem.h"
 #include "varupdatehelper.h"
 #include "watchalgos.h"
+#include "binpropsimd.h"
 
 using namespace CMSat;
 using std::cout;
@@ -89,8 +90,8 @@ void PropEngine::attach_tri_clause(
     assert(value(lit1.var()) == l_Undef);
     assert(value(lit2) == l_Undef || value(lit2) == l_False);
 
-    assert(varData[lit1.var()].removed == Removed::none);
-    assert(varData[lit2.var()].removed == Removed::none);
+    assert(varDataCold[lit1.var()].removed == Removed::none);
+    assert(varDataCold[lit2.var()].removed == Removed::none);
     #endif //DEBUG_ATTACH
 
     //Order them
@@ -152,8 +153,8 @@ void PropEngine::attach_bin_clause(
         assert(value(lit2) == l_Undef || value(lit2) == l_False);
     }
 
-    assert(varData[lit1.var()].removed == Removed::none);
-    assert(varData[lit2.var()].removed == Removed::none);
+    assert(varDataCold[lit1.var()].removed == Removed::none);
+    assert(varDataCold[lit2.var()].removed == Removed::none);
     #endif //DEBUG_ATTACH
 
     watches[lit1.toInt()].push(Watched(lit2, red));
@@ -182,15 +183,16 @@ void PropEngine::attachClause(
 
     #ifdef DEBUG_ATTACH
     for (uint32_t i = 0; i < c.size(); i++) {
-        assert(varData[c[i].var()].removed == Removed::none);
+        assert(varDataCold[c[i].var()].removed == Removed::none);
     }
     #endif //DEBUG_ATTACH
 
     const ClOffset offset = cl_alloc.get_offset(&c);
 
     const Lit blocked_lit = find_good_blocked_lit(c);
-    watches[c[0].toInt()].push(Watched(offset, blocked_lit));
-    watches[c[1].toInt()].push(Watched(offset, blocked_lit));
+    const Watched w = long_cl_watch(offset, blocked_lit, c);
+    watches[c[0].toInt()].push(w);
+    watches[c[1].toInt()].push(w);
 }
 
 /**
@@ -262,15 +264,17 @@ void PropEngine::update_glue(Clause& c)
         && conf.update_glues_on_prop
     ) {
         const uint32_t new_glue = calc_glue_using_seen2(c);
+        const bool was_reducedb = red_long_cls_is_reducedb(c);
         if (new_glue < c.stats.glue
             && new_glue < conf.protect_clause_if_imrpoved_glue_below_this_glue_for_one_turn
         ) {
-            if (red_long_cls_is_reducedb(c)) {
-                num_red_cls_reducedb--;
-            }
             c.stats.ttl = 1;
         }
         c.stats.glue = std::min(c.stats.glue, new_glue);
+        update_red_tier(c.stats);
+        if (was_reducedb && !red_long_cls_is_reducedb(c)) {
+            num_red_cls_reducedb--;
+        }
     }
 }
 
@@ -293,7 +297,7 @@ PropResult PropEngine::prop_normal_helper(
 
     // If 0th watch is true, then clause is already satisfied.
     if (value(c[0]) == l_True) {
-        *j = Watched(offset, c[0]);
+        *j = long_cl_watch(offset, c[0], c);
         j++;
         return PROP_NOTHING;
     }
@@ -307,7 +311,7 @@ PropResult PropEngine::prop_normal_helper(
         if (value(*k) != l_False) {
             c[1] = *k;
             *k = ~p;
-            watches[c[1].toInt()].push(Watched(offset, c[0]));
+            watches[c[1].toInt()].push(long_cl_watch(offset, c[0], c));
             return PROP_NOTHING;
         }
     }
@@ -400,6 +404,14 @@ bool PropEngine::prop_long_cl_any_order(
         *j++ = *i;
         return true;
     }
+    #ifdef WATCH_CACHED_LITS
+    if (value(i->getCachedLit(0)) == l_True
+        || value(i->getCachedLit(1)) == l_True
+    ) {
+        *j++ = *i;
+        return true;
+    }
+    #endif
     if (update_bogoprops) {
         propStats.bogoProps += 4;
     }
@@ -425,7 +437,8 @@ bool PropEngine::prop_long_cl_any_order(
     // If 0th watch is true, then clause is already satisfied.
     const Lit first = c[0];
     if (first != blocker && value(first) == l_True) {
-        *j = Watched(offset, first);
+        *j = *i;
+        j->setBlockedLit(first);
         j++;
         return true;
     }
@@ -439,7 +452,7 @@ bool PropEngine::prop_long_cl_any_order(
         if (value(*k) != l_False) {
             c[1] = *k;
             *k = ~p;
-            watches[c[1].toInt()].push(Watched(offset, c[0]));
+            watches[c[1].toInt()].push(long_cl_watch(offset, c[0], c));
             return true;
         }
     }
@@ -652,6 +665,9 @@ PropBy PropEngine::propagate_any_order()
     #endif
 
     while (qhead < trail.size() && confl.isNULL()) {
+        if (conf.doPropPrefetch) {
+            prefetch_ahead(qhead);
+        }
         const Lit p = trail[qhead];     // 'p' is enqueued fact to propagate.
         watch_subarray ws = watches[(~p).toInt()];
         watch_subarray::iterator i = ws.begin();
@@ -661,6 +677,34 @@ PropBy PropEngine::propagate_any_order()
             propStats.bogoProps += ws.size()/4 + 1;
         }
 
+        if (use_front_bins) {
+            //Binaries at the front: no type checks, nothing to move
+            const watch_subarray::iterator bin_end = i + num_front_bins[(~p).toInt()];
+            if (use_simd_bins) {
+                for (; bin_end - i >= (ptrdiff_t)BinPropSIMD::lanes
+                    && confl.isNULL()
+                    ; i += BinPropSIMD::lanes
+                ) {
+                    uint32_t todo = BinPropSIMD::not_true(i, assigns.data());
+                    while (todo) {
+                        const unsigned at = __builtin_ctz(todo);
+                        todo &= todo - 1;
+                        if (!prop_bin_cl<update_bogoprops>(i + at, p, confl)) {
+                            break;
+                        }
+                    }
+                }
+            }
+            for (; i < bin_end && confl.isNULL(); i++) {
+                prop_bin_cl<update_bogoprops>(i, p, confl);
+            }
+            if (!confl.isNULL()) {
+                qhead++;
+                break;
+            }
+            j = i;
+        }
+
         for (; i != end; i++) {
             if (i->isBin()) {
                 *j++ = *i;
@@ -705,6 +749,37 @@ PropBy PropEngine::propagate_any_order()
 template PropBy PropEngine::propagate_any_order<true>();
 template PropBy PropEngine::propagate_any_order<false>();
 
+/**
+@brief Moves the binaries to the front of every watchlist, keeping the order
+
+The other watches stay in order as well. Propagation only ever removes
+long clause watches from the lists and appends new watches at the end, so the
+front blocks stay intact until the watchlists are changed outside of search.
+*/
+void PropEngine::move_bins_to_front()
+{
+    num_front_bins.resize(watches.size());
+    for(size_t at = 0; at < watches.size(); at++) {
+        watch_subarray ws = watches[at];
+        watch_subarray::iterator i = ws.begin();
+        watch_subarray::iterator end = ws.end();
+        for(; i != end && i->isBin(); i++);
+
+        watch_subarray::iterator j = i;
+        front_bins_tmp.clear();
+        for(; i != end; i++) {
+            if (i->isBin()) {
+                *j++ = *i;
+            } else {
+                front_bins_tmp.push_back(*i);
+            }
+        }
+        num_front_bins[at] = j - ws.begin();
+        std::copy(front_bins_tmp.begin(), front_bins_tmp.end(), j);
+    }
+    front_bins_dirty = false;
+}
+
 void PropEngine::sortWatched()
 {
     #ifdef VERBOSE_DEBUG
@@ -744,6 +819,7 @@ void PropEngine::sortWatched()
         cout << " -- " << endl;
         #endif //VERBOSE_DEBUG
     }
+    front_bins_dirty = true;
 
     if (conf.verbosity >= 2) {
         cout << "c [w-sort] "
@@ -778,6 +854,7 @@ void PropEngine::updateVars(
     , const vector<uint32_t>& interToOuter2
 ) {
     updateArray(varData, interToOuter);
+    updateArray(varDataCold, interToOuter);
     #ifdef STATS_NEEDED
     updateArray(varDataLT, interToOuter);
     #endif
@@ -837,6 +914,12 @@ inline void PropEngine::updateWatch(
             it->setBlockedLit(
                 getUpdatedLit(it->getBlockedLit(), outerToInter)
             );
+            #ifdef WATCH_CACHED_LITS
+            it->setCachedLits(
+                getUpdatedLit(it->getCachedLit(0), outerToInter)
+                , getUpdatedLit(it->getCachedLit(1), outerToInter)
+            );
+            #endif
         }
     }
 }
@@ -857,6 +940,10 @@ PropBy PropEngine::propagate_strict_order(
     startAgain:
     //Propagate binary clauses first
     while (qhead < trail.size() && confl.isNULL()) {
+        //Clauses are prefetched below, the watchlists are prefetched here
+        if (conf.doPropPrefetch && qhead + 1 < trail.size()) {
+            watches.prefetch((~trail[qhead+1]).toInt());
+        }
         const Lit p = trail[qhead++];     // 'p' is enqueued fact to propagate.
         watch_subarray_const ws = watches[(~p).toInt()];
         #ifdef STATS_NEEDED
@@ -1134,23 +1221,32 @@ bool PropEngine::propagate_long_clause_occur(const ClOffset offset)
 
 
 
+/**
+@brief Sets 'p' at 'level', which may be below the current decision level
+
+With chronological backtracking the trail is not sorted by level: a literal
+implied by a learnt clause is set at the level of the clause's other literals,
+even though the solver stays at a higher level. It goes to the end of the
+trail all the same.
+*/
 template<bool update_bogoprops>
-void PropEngine::enqueue(const Lit p, const PropBy from)
+void PropEngine::enqueue(const Lit p, const uint32_t level, const PropBy from)
 {
+    assert(level <= decisionLevel());
     #ifdef DEBUG_ENQUEUE_LEVEL0
     #ifndef VERBOSE_DEBUG
     if (decisionLevel() == 0)
     #endif //VERBOSE_DEBUG
     cout << "enqueue var " << p.var()+1
     << " to val " << !p.sign()
-    << " level: " << decisionLevel()
+    << " level: " << level
     << " sublevel: " << trail.size()
     << " by: " << from << endl;
     #endif //DEBUG_ENQUEUE_LEVEL0
 
     #ifdef ENQUEUE_DEBUG
     //assert(trail.size() <= nVarsOuter());
-    //assert(decisionLevel() == 0 || varData[p.var()].removed == Removed::none);
+    //assert(decisionLevel() == 0 || varDataCold[p.var()].removed == Removed::none);
     #endif
 
     const Var v = p.var();
@@ -1162,7 +1258,7 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
     const bool sign = p.sign();
     assigns[v] = boolToLBool(!sign);
     varData[v].reason = from;
-    varData[v].level = decisionLevel();
+    varData[v].level = level;
 
     trail.push_back(p);
     propStats.propagations++;
@@ -1191,6 +1287,8 @@ void PropEngine::enqueue(const Lit p, const PropBy from)
     std::cerr << "s " << v << " " << p.sign() << endl;
     #endif
 }
+template void PropEngine::enqueue<true>(const Lit p, const uint32_t level, const PropBy from);
+template void PropEngine::enqueue<false>(const Lit p, const uint32_t level, const PropBy from);
 
 void PropEngine::save_state(SimpleOutFile& f) const
 {
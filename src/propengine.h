@@ -98,11 +98,24 @@ public:
     PropStats propStats;
     template<bool update_bogoprops = true>
     void enqueue(const Lit p, const PropBy from = PropBy());
+    template<bool update_bogoprops = true>
+    void enqueue(const Lit p, const uint32_t level, const PropBy from);
     void new_decision_level();
     bool update_polarity_and_activity = true;
 
 protected:
     virtual Lit find_good_blocked_lit(const Clause& c) const  = 0;
+    static Watched long_cl_watch(ClOffset offset, Lit blocked_lit, const Clause& c)
+    {
+        Watched w(offset, blocked_lit);
+        #ifdef WATCH_CACHED_LITS
+        //Literals beyond the two watched ones are cached in both watches
+        w.setCachedLits(c[2], c[c.size() > 3 ? 3 : 2]);
+        #else
+        (void)c;
+        #endif
+        return w;
+    }
     void new_var(const bool bva, const Var orig_outer) override;
     void new_vars(const size_t n) override;
     void save_on_var_memory();
@@ -123,6 +136,18 @@ protected:
     uint32_t            qhead;            ///< Head of queue (as index into the trail)
     Lit                 failBinLit;       ///< Used to store which watches[lit] we were looking through when conflict occured
 
+    //Binaries at the front of the watchlists
+    void move_bins_to_front();
+    vector<uint32_t>    num_front_bins;   ///< Binaries at the front of 'watches[lit]'. Binaries added later are at the back
+    bool                use_front_bins = false; ///< 'num_front_bins' is valid and propagation may use it
+    bool                front_bins_dirty = true; ///< Watchlists have been changed since move_bins_to_front()
+    bool                use_simd_bins = false; ///< Look up the values of the front binaries with BinPropSIMD
+    vector<Watched>     front_bins_tmp;
+
+    //Prefetching for the literals coming up on the trail
+    void prefetch_ahead(const uint32_t at) const;
+    void prefetch_long_cls(const uint32_t ws_at) const;
+
     template<bool update_bogoprops>
     PropBy propagate_any_order();
     PropBy propagate_strict_order(
@@ -281,6 +306,12 @@ inline uint32_t PropEngine::decisionLevel() const
     return trail_lim.size();
 }
 
+template<bool update_bogoprops>
+inline void PropEngine::enqueue(const Lit p, const PropBy from)
+{
+    enqueue<update_bogoprops>(p, decisionLevel(), from);
+}
+
 inline uint32_t PropEngine::nAssigns() const
 {
     return trail.size();
@@ -342,6 +373,43 @@ uint32_t PropEngine::calc_glue_using_seen2_upper_bit_no_zero_lev(const T& ps)
 }
 
 
+/**
+@brief Prefetch for trail[at+1] and trail[at+2], called when propagating trail[at]
+
+Two stages: the watchlist of trail[at+2] is fetched now, so that by the time
+trail[at+1] is being propagated, the clauses referenced from its watchlist can
+be looked up without a stall.
+*/
+inline void PropEngine::prefetch_ahead(const uint32_t at) const
+{
+    if (at + 2 < trail.size()) {
+        watches.prefetch((~trail[at+2]).toInt());
+    }
+    if (at + 1 < trail.size()) {
+        prefetch_long_cls((~trail[at+1]).toInt());
+    }
+}
+
+inline void PropEngine::prefetch_long_cls(const uint32_t ws_at) const
+{
+    watch_subarray_const ws = watches[ws_at];
+    watch_subarray_const::const_iterator i = ws.begin();
+    if (use_front_bins) {
+        i += num_front_bins[ws_at];
+    }
+    const watch_subarray_const::const_iterator end = ws.end();
+    uint32_t todo = conf.prop_prefetch_cls;
+    for (uint32_t looked = 0
+        ; i != end && todo > 0 && looked < 4*conf.prop_prefetch_cls
+        ; i++, looked++
+    ) {
+        if (i->isClause() && value(i->getBlockedLit()) != l_True) {
+            __builtin_prefetch(cl_alloc.ptr(i->get_offset()));
+            todo--;
+        }
+    }
+}
+
 inline bool PropEngine::getStoredPolarity(const Var var)
 {
     return varData[var].polarity;
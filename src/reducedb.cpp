@@ -24,6 +24,7 @@
 #include "sqlstats.h"
 #include "clausecleaner.h"
 #include <functional>
+#include <algorithm>
 
 using namespace CMSat;
 
@@ -77,21 +78,31 @@ ReduceDB::ReduceDB(Solver* _solver) :
 {
 }
 
-void ReduceDB::sort_red_cls(ClauseClean clean_type)
+/**
+@brief Moves the best 'keep_num' of the first 'num' clauses of longRedCls to the front
+
+The first 'num' clauses must all be eligible for marking. Only the order
+around position 'keep_num' is computed, so this is linear in 'num' where a
+full sort was O(num log num).
+*/
+void ReduceDB::select_red_cls(ClauseClean clean_type, const size_t num, const uint64_t keep_num)
 {
+    vector<ClOffset>::iterator begin = solver->longRedCls.begin();
+    vector<ClOffset>::iterator nth = begin + keep_num;
+    vector<ClOffset>::iterator end = begin + num;
     switch (clean_type) {
         case ClauseClean::glue : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsGlue(solver->cl_alloc));
+            std::nth_element(begin, nth, end, SortRedClsGlue(solver->cl_alloc));
             break;
         }
 
         case ClauseClean::size : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsSize(solver->cl_alloc));
+            std::nth_element(begin, nth, end, SortRedClsSize(solver->cl_alloc));
             break;
         }
 
         case ClauseClean::activity : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsAct(solver->cl_alloc));
+            std::nth_element(begin, nth, end, SortRedClsAct(solver->cl_alloc));
             break;
         }
 
@@ -122,26 +133,32 @@ CleaningStats ReduceDB::reduceDB()
         if (keep_num == 0) {
             continue;
         }
-        sort_red_cls(static_cast<ClauseClean>(keep_type));
-        mark_top_N_clauses(keep_num);
+        mark_top_N_clauses(static_cast<ClauseClean>(keep_type), keep_num);
     }
     move_from_never_cleaned();
+    tmpStats.select_time = cpuTime() - myTime;
     assert(delayed_clause_free.empty());
     cl_locked = 0;
     cl_marked = 0;
     cl_glue = 0;
+    cl_tier2 = 0;
     cl_ttl = 0;
     cl_locked_solver = 0;
+    const double remove_start = cpuTime();
     remove_cl_from_array_and_count_stats(tmpStats, sumConfl);
+    tmpStats.remove_time = cpuTime() - remove_start;
     if (solver->conf.verbosity >= 2) {
         cout << "c [DBclean] locked:" << cl_locked
         << " marked: " << cl_marked
         << " glue: " << cl_glue
+        << " tier2: " << cl_tier2
+        << " tier2 demoted: " << tmpStats.tier2_demoted
         << " ttl:" << cl_ttl
         << " locked_solver:" << cl_locked_solver
         << endl;
     }
 
+    const double free_start = cpuTime();
     solver->clean_occur_from_removed_clauses_only_smudged();
     solver->watches.clear_smudged();
     for(ClOffset offset: delayed_clause_free) {
@@ -151,6 +168,7 @@ CleaningStats ReduceDB::reduceDB()
     delayed_clause_free.clear();
     solver->unmark_all_red_clauses();
     solver->check_no_removed_or_freed_cl_in_watch();
+    tmpStats.free_time = cpuTime() - free_start;
 
     tmpStats.cpu_time = cpuTime() - myTime;
     if (solver->conf.verbosity >= 4)
@@ -200,29 +218,32 @@ void ReduceDB::move_from_never_cleaned()
     never_cleaned.clear();
 }
 
-void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
+void ReduceDB::mark_top_N_clauses(ClauseClean clean_type, const uint64_t keep_num)
 {
-    size_t marked = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls.size() && marked < keep_num
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        if ( cl->stats.locked
-            || cl->stats.marked_clause
-            || cl->stats.glue <= solver->conf.glue_must_keep_clause_if_below_or_eq
-            || cl->stats.ttl > 0
-            || solver->clause_locked(*cl, offset)
-        ) {
-            //no need to mark, skip
-            continue;
+    //Clauses that are kept anyway, or by an earlier criterion, don't compete.
+    //This pass and the selection are linear in the size of longRedCls
+    const vector<ClOffset>::iterator eligible_end = std::partition(
+        solver->longRedCls.begin()
+        , solver->longRedCls.end()
+        , [&](const ClOffset offset) {
+            const Clause* cl = solver->cl_alloc.ptr(offset);
+            return !cl->stats.locked
+                && !cl->stats.marked_clause
+                && cl->stats.glue > solver->conf.glue_must_keep_clause_if_below_or_eq
+                && cl->stats.which_red_array == red_local
+                && cl->stats.ttl == 0
+                && !solver->clause_locked(*cl, offset);
         }
+    );
+    const size_t num = eligible_end - solver->longRedCls.begin();
+    if (keep_num < num) {
+        select_red_cls(clean_type, num, keep_num);
+    }
 
-        if (!cl->stats.marked_clause) {
-            marked++;
-            cl->stats.marked_clause = true;
-        }
+    const size_t to_mark = std::min<uint64_t>(keep_num, num);
+    for(size_t i = 0; i < to_mark; i++) {
+        Clause* cl = solver->cl_alloc.ptr(solver->longRedCls[i]);
+        cl->stats.marked_clause = true;
     }
 }
 
@@ -245,6 +266,7 @@ bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
          && !cl->stats.marked_clause
          && cl->stats.ttl == 0
          && cl->stats.glue > solver->conf.glue_must_keep_clause_if_below_or_eq
+         && cl->stats.which_red_array == red_local
          && !solver->clause_locked(*cl, offset);
 }
 
@@ -269,6 +291,8 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
             cl_ttl++;
         } else if (cl->stats.glue <= solver->conf.glue_must_keep_clause_if_below_or_eq) {
             cl_glue++;
+        } else if (cl->stats.which_red_array != red_local) {
+            cl_tier2++;
         } else if (solver->clause_locked(*cl, offset)) {
             cl_locked_solver++;
         }
@@ -277,6 +301,7 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
             if (cl->stats.ttl > 0) {
                 cl->stats.ttl = 0;
             }
+            update_tier(cl, tmpStats);
             solver->longRedCls[j++] = offset;
             tmpStats.remain.incorporate(cl, sumConfl);
             continue;
@@ -295,6 +320,38 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
     solver->longRedCls.resize(solver->longRedCls.size() - (i - j));
 }
 
+/**
+@brief Demotes the tier2 clauses not used since the last cleaning
+
+They only compete with the local clauses from the next cleaning on, so they
+have one more round to be used and get their activity up. The glue limits of
+the tiers may have been changed since the last cleaning, so they are applied
+again first.
+*/
+void ReduceDB::update_tier(Clause* cl, CleaningStats& tmpStats)
+{
+    solver->update_red_tier(cl->stats);
+    if (cl->stats.which_red_array == red_tier2
+        && !cl->stats.used_since_clean
+    ) {
+        cl->stats.which_red_array = red_local;
+        tmpStats.tier2_demoted++;
+    }
+    cl->stats.used_since_clean = 0;
+
+    switch(cl->stats.which_red_array) {
+        case red_core:
+            tmpStats.core++;
+            break;
+        case red_tier2:
+            tmpStats.tier2++;
+            break;
+        default:
+            tmpStats.local++;
+            break;
+    }
+}
+
 void ReduceDB::reduce_db_and_update_reset_stats()
 {
     ClauseUsageStats irred_cl_usage_stats = sumClauseData(solver->longIrredCls);
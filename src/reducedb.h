@@ -57,6 +57,7 @@ private:
     unsigned cl_marked;
     unsigned cl_ttl;
     unsigned cl_glue;
+    unsigned cl_tier2;
     unsigned cl_locked_solver;
 
     size_t last_reducedb_num_conflicts = 0;
@@ -64,6 +65,7 @@ private:
     void clear_clauses_stats(vector<ClOffset>& clauseset);
 
     bool cl_needs_removal(const Clause* cl, const ClOffset offset) const;
+    void update_tier(Clause* cl, CleaningStats& tmpStats);
     void remove_cl_from_array_and_count_stats(
         CleaningStats& tmpStats
         , uint64_t sumConflicts
@@ -72,8 +74,8 @@ private:
     CleaningStats reduceDB();
     void lock_most_UIP_used_clauses();
 
-    void sort_red_cls(ClauseClean clean_type);
-    void mark_top_N_clauses(const uint64_t keep_num);
+    void select_red_cls(ClauseClean clean_type, const size_t num, const uint64_t keep_num);
+    void mark_top_N_clauses(ClauseClean clean_type, const uint64_t keep_num);
     ClauseUsageStats sumClauseData(
         const vector<ClOffset>& toprint
     ) const;
@@ -96,7 +96,7 @@ void SCCFinder::tarjan(const uint32_t vertex)
     stackIndicator[vertex] = true;
 
     Var vertexVar = Lit::toLit(vertex).var();
-    if (solver->varData[vertexVar].removed == Removed::none) {
+    if (solver->varDataCold[vertexVar].removed == Removed::none) {
         Lit vertLit = Lit::toLit(vertex);
 
         vector<LitExtra>* transCache = NULL;
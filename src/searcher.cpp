@@ -33,6 +33,9 @@
 #include "sqlstats.h"
 #include "datasync.h"
 #include "reducedb.h"
+#include "distiller.h"
+#include "binpropsimd.h"
+#include "watchalgos.h"
 //#define DEBUG_RESOLV
 
 using namespace CMSat;
@@ -125,7 +128,7 @@ void Searcher::add_lit_to_learnt(
     const Lit lit
 ) {
     const Var var = lit.var();
-    assert(varData[var].removed == Removed::none);
+    assert(varDataCold[var].removed == Removed::none);
 
     //If var is at level 0, don't do anything with it, just skip
     if (varData[var].level == 0)
@@ -395,17 +398,16 @@ void Searcher::update_clause_glue_from_analysis(Clause* cl)
         //tot_lbds = tot_lbds - c.lbd() + lbd;
         //c.delta_lbd(c.delta_lbd() + c.lbd() - lbd);
 
-        if (new_glue <= conf.glue_must_keep_clause_if_below_or_eq && red_long_cls_is_reducedb(*cl)) {
-            num_red_cls_reducedb--;
-        }
+        const bool was_reducedb = red_long_cls_is_reducedb(*cl);
         cl->stats.glue = new_glue;
+        update_red_tier(cl->stats);
 
         if (new_glue <= conf.protect_clause_if_imrpoved_glue_below_this_glue_for_one_turn) {
-            if (red_long_cls_is_reducedb(*cl)) {
-                num_red_cls_reducedb--;
-            }
             cl->stats.ttl = 1;
         }
+        if (was_reducedb && !red_long_cls_is_reducedb(*cl)) {
+            num_red_cls_reducedb--;
+        }
     }
 }
 
@@ -452,8 +454,12 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             #ifdef STATS_NEEDED
             cl->stats.used_for_uip_creation++;
             #endif
+            if (cl->stats.imported) {
+                solver->datasync->imported_clause_used(cl->stats);
+            }
             if (cl->red() && update_polarity_and_activity) {
                 bumpClauseAct(cl);
+                cl->stats.used_since_clean = 1;
                 if (conf.update_glues_on_analyze) {
                     update_clause_glue_from_analysis(cl);
                 }
@@ -501,6 +507,13 @@ void Searcher::minimize_learnt_clause()
 
 void Searcher::mimimize_learnt_clause_more_maybe()
 {
+    if (conf.doMinimRedBinGraph
+        && learnt_clause.size() > 1
+        && binTri.irredBins + binTri.redBins > 0
+    ) {
+        binary_graph_more_minim(learnt_clause);
+    }
+
     if (conf.doMinimRedMore
         && learnt_clause.size() > 1
         && (conf.doAlwaysFMinim
@@ -574,10 +587,12 @@ inline Clause* Searcher::create_learnt_clause(PropBy confl)
 
         last_resolved_long_cl = add_literals_from_confl_to_learnt(confl, p);
 
-        // Select next implication to look at
-        while (!seen[trail[index--].var()]);
-
-        p = trail[index+1];
+        // Select next implication to look at. With chronological
+        // backtracking, lower level literals can be in between
+        do {
+            while (!seen[trail[index--].var()]);
+            p = trail[index+1];
+        } while (varData[p.var()].level < decisionLevel());
         assert(p != lit_Undef);
 
         if (update_polarity_and_activity
@@ -1016,6 +1031,7 @@ lbool Searcher::search()
         } else {
             assert(ok);
             reduce_db_if_needed();
+            poll_terminate_callback(propStats.propagations);
             check_need_restart();
             last_decision_ended_in_conflict = false;
             const lbool ret = new_decision();
@@ -1043,6 +1059,28 @@ lbool Searcher::search()
     return l_Undef;
 }
 
+/**
+@brief search() with the binaries at the front of the watchlists
+
+Only search() keeps the front blocks intact, so the rest of the system never
+propagates using them.
+*/
+lbool Searcher::search_with_front_bins()
+{
+    if (conf.doBinBlockFirst) {
+        if (front_bins_dirty) {
+            move_bins_to_front();
+        }
+        use_front_bins = true;
+        use_simd_bins = conf.doSIMDBinProp && BinPropSIMD::available();
+    }
+    const lbool status = search();
+    use_front_bins = false;
+    use_simd_bins = false;
+
+    return status;
+}
+
 void Searcher::dump_search_sql(const double myTime)
 {
     if (solver->sqlStats && conf.dump_individual_search_time) {
@@ -1066,7 +1104,7 @@ lbool Searcher::new_decision()
     while (decisionLevel() < assumptions.size()) {
         // Perform user provided assumption:
         Lit p = assumptions[decisionLevel()].lit_inter;
-        assert(varData[p.var()].removed == Removed::none);
+        assert(varDataCold[p.var()].removed == Removed::none);
 
         if (value(p) == l_True) {
             // Dummy decision level:
@@ -1332,14 +1370,25 @@ void Searcher::update_history_stats(size_t backtrack_level, size_t glue)
     hist.trailDepthDeltaHist.push(trail.size() - trail_lim[backtrack_level]);
 }
 
-void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
-{
+/**
+@brief Attaches the learnt clause and sets its UIP at the backtrack level
+
+After a chronological backtrack the current level is higher than that, so the
+UIP goes out of order on the trail.
+*/
+void Searcher::attach_and_enqueue_learnt_clause(
+    Clause* cl
+    , const uint32_t glue
+    , const uint32_t backtrack_level
+) {
+    solver->datasync->signalNewLearnt(learnt_clause, glue);
     switch (learnt_clause.size()) {
         case 0:
             assert(false);
         case 1:
             //Unitary learnt
             stats.learntUnits++;
+            solver->datasync->signalNewUnitClause(learnt_clause[0]);
             enqueue(learnt_clause[0]);
             assert(decisionLevel() == 0);
 
@@ -1353,7 +1402,7 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
             stats.learntBins++;
             solver->datasync->signalNewBinClause(learnt_clause);
             solver->attach_bin_clause(learnt_clause[0], learnt_clause[1], true);
-            enqueue(learnt_clause[0], PropBy(learnt_clause[1], true));
+            enqueue(learnt_clause[0], backtrack_level, PropBy(learnt_clause[1], true));
 
             #ifdef STATS_NEEDED
             propStats.propsBinRed++;
@@ -1363,8 +1412,9 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
         case 3:
             //3-long learnt
             stats.learntTris++;
+            solver->datasync->signalNewLongClause(learnt_clause, glue);
             solver->attach_tri_clause(learnt_clause[0], learnt_clause[1], learnt_clause[2], true);
-            enqueue(learnt_clause[0], PropBy(learnt_clause[1], learnt_clause[2], true));
+            enqueue(learnt_clause[0], backtrack_level, PropBy(learnt_clause[1], learnt_clause[2], true));
 
             #ifdef STATS_NEEDED
             propStats.propsTriRed++;
@@ -1375,8 +1425,9 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
             //Long learnt
             cl->stats.resolutions = resolutions;
             stats.learntLongs++;
+            solver->datasync->signalNewLongClause(learnt_clause, glue);
             solver->attachClause(*cl);
-            enqueue(learnt_clause[0], PropBy(cl_alloc.get_offset(cl)));
+            enqueue(learnt_clause[0], backtrack_level, PropBy(cl_alloc.get_offset(cl)));
 
             #ifdef STATS_NEEDED
             propStats.propsLongRed++;
@@ -1417,8 +1468,9 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
     //No on-the-fly subsumption
     if (cl == NULL) {
         if (learnt_clause.size() > 3) {
-            cl = cl_alloc.Clause_new(learnt_clause, Searcher::sumConflicts());
+            cl = cl_alloc.Clause_new(learnt_clause, Searcher::sumConflicts(), true);
             cl->makeRed(glue);
+            update_red_tier(cl->stats);
             ClOffset offset = cl_alloc.get_offset(cl);
             solver->longRedCls.push_back(offset);
             return cl;
@@ -1450,6 +1502,7 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
     //Update stats
     if (cl->red() && cl->stats.glue > glue) {
         cl->stats.glue = glue;
+        update_red_tier(cl->stats);
     }
     #ifdef STATS_NEEDED
     cl->stats.conflicts_made += conf.rewardShortenedClauseWithConfl;
@@ -1471,6 +1524,16 @@ bool Searcher::handle_conflict(const PropBy confl)
     if (decisionLevel() == 0)
         return false;
 
+    if (chrono_backtrack_allowed()) {
+        const lbool ret = backtrack_to_conflict_level(confl);
+        if (ret == l_False) {
+            return false;
+        }
+        if (ret == l_True) {
+            return true;
+        }
+    }
+
     Clause* cl = analyze_conflict(
         confl
         , backtrack_level  //return backtrack level here
@@ -1482,7 +1545,17 @@ bool Searcher::handle_conflict(const PropBy confl)
     if (params.update) {
         update_history_stats(backtrack_level, glue);
     }
-    cancelUntil(backtrack_level);
+    if (chrono_backtrack_allowed()
+        && backtrack_level > 0
+        && backtrack_level + 1 < decisionLevel()
+        && decisionLevel() - backtrack_level > (uint32_t)conf.chrono_backtrack
+    ) {
+        stats.chronoBacktrack++;
+        stats.chronoTrailKept += trail_lim[decisionLevel()-1] - trail_lim[backtrack_level];
+        cancelUntil(decisionLevel()-1);
+    } else {
+        cancelUntil(backtrack_level);
+    }
 
     add_otf_subsume_long_clauses();
     add_otf_subsume_implicit_clause();
@@ -1491,7 +1564,7 @@ bool Searcher::handle_conflict(const PropBy confl)
     glue = std::min<uint32_t>(glue, std::numeric_limits<uint32_t>::max());
     cl = handle_last_confl_otf_subsumption(cl, glue);
     assert(learnt_clause.size() <= 3 || cl != NULL);
-    attach_and_enqueue_learnt_clause(cl);
+    attach_and_enqueue_learnt_clause(cl, glue, backtrack_level);
 
     varDecayActivity();
     decayClauseAct();
@@ -1499,6 +1572,116 @@ bool Searcher::handle_conflict(const PropBy confl)
     return true;
 }
 
+/**
+@brief Backtracks to the highest level of the conflict, if that's below the current one
+
+With chronological backtracking the conflict can be entirely below the current
+decision level. Its two highest literals are moved to the watches, so they are
+unset first. If only one literal is at the highest level, the conflict is
+an implication that was missed: that literal is set at the level of the
+others and there is nothing to learn.
+
+@return l_False if the conflict is at level 0, l_True if it was a missed
+implication, l_Undef if it has to be analysed
+*/
+lbool Searcher::backtrack_to_conflict_level(const PropBy confl)
+{
+    Lit implicit[3];
+    Lit* lits;
+    size_t size;
+    Clause* cl = NULL;
+    switch (confl.getType()) {
+        case binary_t:
+            implicit[0] = failBinLit;
+            implicit[1] = confl.lit2();
+            lits = implicit;
+            size = 2;
+            break;
+
+        case tertiary_t:
+            implicit[0] = failBinLit;
+            implicit[1] = confl.lit2();
+            implicit[2] = confl.lit3();
+            lits = implicit;
+            size = 3;
+            break;
+
+        case clause_t:
+            cl = cl_alloc.ptr(confl.get_offset());
+            lits = cl->begin();
+            size = cl->size();
+            break;
+
+        case null_clause_t:
+        default:
+            assert(false && "Conflict must have a reason");
+            return l_Undef;
+    }
+
+    //Put the highest at 0, the next highest at 1
+    const Lit old_watch[2] = {lits[0], lits[1]};
+    for (size_t at = 0; at < 2; at++) {
+        size_t max_i = at;
+        for (size_t i = at+1; i < size; i++) {
+            if (varData[lits[i].var()].level > varData[lits[max_i].var()].level)
+                max_i = i;
+        }
+        std::swap(lits[at], lits[max_i]);
+    }
+    if (cl != NULL) {
+        const ClOffset offset = confl.get_offset();
+        for (size_t at = 0; at < 2; at++) {
+            if (old_watch[at] != lits[0] && old_watch[at] != lits[1]) {
+                removeWCl(watches[old_watch[at].toInt()], offset);
+            }
+            if (lits[at] != old_watch[0] && lits[at] != old_watch[1]) {
+                watches[lits[at].toInt()].push(long_cl_watch(offset, lits[at^1], *cl));
+            }
+        }
+    }
+
+    const uint32_t top_level = varData[lits[0].var()].level;
+    const uint32_t next_level = varData[lits[1].var()].level;
+    if (top_level == 0) {
+        cancelUntil(0);
+        *drup << fin;
+        return l_False;
+    }
+
+    if (top_level == next_level) {
+        cancelUntil(top_level);
+        return l_Undef;
+    }
+
+    //Missed implication
+    stats.chronoMissedImpl++;
+    if (next_level == 0) {
+        cancelUntil(0);
+        enqueue(lits[0]);
+        *drup << lits[0] << fin;
+        return l_True;
+    }
+
+    cancelUntil(top_level-1);
+    PropBy by;
+    switch (confl.getType()) {
+        case binary_t:
+            by = PropBy(lits[1], confl.isRedStep());
+            break;
+
+        case tertiary_t:
+            by = PropBy(lits[1], lits[2], confl.isRedStep());
+            break;
+
+        default:
+            by = confl;
+            break;
+    }
+    enqueue(lits[0], next_level, by);
+
+    return l_True;
+}
+
 void Searcher::resetStats()
 {
     startTime = cpuTime();
@@ -1535,7 +1718,7 @@ lbool Searcher::burst_search()
     params.clear();
     params.conflictsToDo = conf.burst_search_len;
     params.rest_type = Restart::never;
-    lbool status = search();
+    lbool status = search_with_front_bins();
 
     //Restore config
     conf.random_var_freq = backup_rand;
@@ -1704,7 +1887,7 @@ void Searcher::restore_order_heap()
 {
     order_heap.clear();
     for(size_t var = 0; var < nVars(); var++) {
-        if (solver->varData[var].removed == Removed::none
+        if (solver->varDataCold[var].removed == Removed::none
             && value(var) == l_Undef
         ) {
             insertVarOrder(var);
@@ -1738,6 +1921,7 @@ void Searcher::reduce_db_if_needed()
             watches.print_stat();
         }
         must_consolidate_mem = true;
+        must_distill_red = conf.do_distill_red_clauses;
         watches.consolidate();
         conf.cur_max_temp_red_cls *= conf.inc_max_temp_red_cls;
 
@@ -1755,6 +1939,7 @@ void Searcher::clean_clauses_if_needed()
 
         lastCleanZeroDepthAssigns = trail.size();
         solver->clauseCleaner->remove_and_clean_all();
+        front_bins_dirty = true;
     }
 }
 
@@ -1776,6 +1961,7 @@ lbool Searcher::perform_scc_and_varreplace_if_needed()
         }
 
         solver->clauseCleaner->remove_and_clean_all();
+        front_bins_dirty = true;
 
         lastCleanZeroDepthAssigns = trail.size();
         if (!solver->varReplacer->replace_if_enough_is_found(floor((double)solver->get_num_free_vars()*0.001))) {
@@ -1867,6 +2053,7 @@ lbool Searcher::solve(
     }
 
     resetStats();
+    front_bins_dirty = true;
     lbool status = l_Undef;
     if (conf.burst_search_len > 0
         && upper_level_iteration_num > 0
@@ -1927,7 +2114,7 @@ lbool Searcher::solve(
         lastRestartConfl = sumConflicts();
         params.clear();
         params.conflictsToDo = max_confl_per_search_solve_call-stats.conflStats.numConflicts;
-        status = search();
+        status = search_with_front_bins();
 
         switch (params.rest_type) {
             case Restart::geom:
@@ -1954,13 +2141,28 @@ lbool Searcher::solve(
             }
         }
 
+        //Needs level 0, so it's not done straight after the cleaning
+        if (must_distill_red) {
+            must_distill_red = false;
+            if (!solver->distiller->distill_red_cls()) {
+                status = l_False;
+                goto end;
+            }
+        }
+
         save_search_loop_stats();
         if (must_consolidate_mem) {
-            cl_alloc.consolidate(solver);
+            //Only clauses in nursery slabs move. SCC, variable replacement and
+            //distillation may have changed them since the cleaning, but at
+            //level 0 every clause is still only referenced from the clause
+            //lists and the watchlists of its first two literals
+            cl_alloc.consolidate_nursery(solver);
             must_consolidate_mem = false;
-
-            //TODO complete detach-reattacher cannot count num_red_cls_reducedb
-            num_red_cls_reducedb = count_num_red_cls_reducedb();
+            #ifdef SLOW_DEBUG
+            find_all_attach();
+            find_all_attach(longIrredCls);
+            find_all_attach(longRedCls);
+            #endif
         }
     }
 
@@ -1973,21 +2175,21 @@ lbool Searcher::solve(
 void Searcher::print_solution_varreplace_status() const
 {
     for(size_t var = 0; var < nVarsOuter(); var++) {
-        if (varData[var].removed == Removed::replaced
-            || varData[var].removed == Removed::elimed
+        if (varDataCold[var].removed == Removed::replaced
+            || varDataCold[var].removed == Removed::elimed
         ) {
             assert(value(var) == l_Undef || varData[var].level == 0);
         }
 
         if (conf.verbosity >= 6
-            && varData[var].removed == Removed::replaced
+            && varDataCold[var].removed == Removed::replaced
             && value(var) != l_Undef
         ) {
             cout
             << "var: " << var
             << " value: " << value(var)
             << " level:" << varData[var].level
-            << " type: " << removed_type_to_string(varData[var].removed)
+            << " type: " << removed_type_to_string(varDataCold[var].removed)
             << endl;
         }
     }
@@ -2093,7 +2295,7 @@ Lit Searcher::pickBranchLit()
             const Var next_var = order_heap.random_element(mtrand);
 
             if (value(next_var) == l_Undef
-                && solver->varData[next_var].removed == Removed::none
+                && solver->varDataCold[next_var].removed == Removed::none
             ) {
                 stats.decisionsRand++;
                 next = Lit(next_var, !pickPolarity(next_var));
@@ -2106,7 +2308,7 @@ Lit Searcher::pickBranchLit()
         Var next_var = var_Undef;
         while (next_var == var_Undef
           || value(next_var) != l_Undef
-          || solver->varData[next_var].removed != Removed::none
+          || solver->varDataCold[next_var].removed != Removed::none
         ) {
             //There is no more to branch on. Satisfying assignment found.
             if (order_heap.empty()) {
@@ -2144,7 +2346,7 @@ Lit Searcher::pickBranchLit()
         //Update
         if (lit2 != lit_Undef
             && value(lit2.var()) == l_Undef
-            && solver->varData[lit2.var()].removed == Removed::none
+            && solver->varDataCold[lit2.var()].removed == Removed::none
         ) {
             //Dominator may not actually dominate this variabe
             //So just to be sure, re-insert it
@@ -2165,7 +2367,7 @@ Lit Searcher::pickBranchLit()
 
     //No vars in heap: solution found
     if (next != lit_Undef) {
-        assert(solver->varData[next.var()].removed == Removed::none);
+        assert(solver->varDataCold[next.var()].removed == Removed::none);
     }
     return next;
 }
@@ -2245,6 +2447,92 @@ void Searcher::binary_based_more_minim(vector<Lit>& cl)
     }
 }
 
+/**
+@brief Removes literals of the learnt clause that binary implication chains make redundant
+
+If ~lit implies x through binary clauses and ~x is in the clause, then
+(lit V x) is implied, and resolving with it removes ~x. So the implication
+graph is walked depth-first from the negation of every literal still in the
+clause. A literal is visited only once per clause, its bit is set in
+bin_graph_visited, and the walk stops after conf.bin_graph_minim_max_steps
+watches. It is cheap enough to run on every learnt clause, unlike
+binary_based_more_minim() that looks only at direct binaries of the first few
+literals.
+*/
+void Searcher::binary_graph_more_minim(vector<Lit>& cl)
+{
+    const double myTime = cpuTime();
+    const size_t origSize = cl.size();
+    if (bin_graph_visited.size()*64 < watches.size()) {
+        bin_graph_visited.resize((watches.size() + 63)/64, 0);
+    }
+    for (const Lit lit: cl) {
+        seen[lit.toInt()] = 1;
+    }
+
+    int64_t limit = conf.bin_graph_minim_max_steps;
+    for (size_t at = 0; at < cl.size() && limit > 0; at++) {
+        const Lit lit = cl[at];
+
+        //Already removed this literal
+        if (seen[lit.toInt()] == 0)
+            continue;
+
+        //Marked first, so no walk comes back to it and removes 'lit'
+        const Lit start = ~lit;
+        if (bin_graph_visited[start.toInt()/64] & (1ULL << (start.toInt()%64)))
+            continue;
+        bin_graph_visited[start.toInt()/64] |= 1ULL << (start.toInt()%64);
+        bin_graph_visited_lits.push_back(start);
+        bin_graph_stack.push_back(start);
+
+        while (!bin_graph_stack.empty() && limit > 0) {
+            const Lit p = bin_graph_stack.back();
+            bin_graph_stack.pop_back();
+
+            //p being true makes lit2 of every binary in watches[~p] true
+            watch_subarray_const ws = watches[(~p).toInt()];
+            limit -= (int64_t)ws.size();
+            for (const Watched& w: ws) {
+                if (!w.isBin())
+                    continue;
+
+                const Lit q = w.lit2();
+                if (bin_graph_visited[q.toInt()/64] & (1ULL << (q.toInt()%64)))
+                    continue;
+                bin_graph_visited[q.toInt()/64] |= 1ULL << (q.toInt()%64);
+                bin_graph_visited_lits.push_back(q);
+
+                //never remove the 0th literal, see minimise_redundant_more()
+                if (seen[(~q).toInt()] && ~q != cl[0]) {
+                    seen[(~q).toInt()] = 0;
+                    stats.binGraphShrinkLit++;
+                }
+                bin_graph_stack.push_back(q);
+            }
+        }
+    }
+    bin_graph_stack.clear();
+    for (const Lit lit: bin_graph_visited_lits) {
+        bin_graph_visited[lit.toInt()/64] = 0;
+    }
+    bin_graph_visited_lits.clear();
+
+    //Remove the literals that have seen[literal] = 0
+    vector<Lit>::iterator i = cl.begin();
+    vector<Lit>::iterator j = i;
+    for (vector<Lit>::iterator end = cl.end(); i != end; i++) {
+        if (seen[i->toInt()]) {
+            *j++ = *i;
+        }
+        seen[i->toInt()] = 0;
+    }
+    cl.resize(cl.size() - (i-j));
+
+    stats.binGraphShrinkCl += (origSize != cl.size());
+    stats.binGraphShrinkTime += cpuTime() - myTime;
+}
+
 void Searcher::minimise_redundant_more(vector<Lit>& cl)
 {
     stats.furtherShrinkAttempt++;
@@ -2321,7 +2609,7 @@ void Searcher::stamp_based_more_minim(vector<Lit>& cl)
 
 bool Searcher::VarFilter::operator()(uint32_t var) const
 {
-    return (cc->value(var) == l_Undef && solver->varData[var].removed == Removed::none);
+    return (cc->value(var) == l_Undef && solver->varDataCold[var].removed == Removed::none);
 }
 
 uint64_t Searcher::sumConflicts() const
@@ -2836,7 +3124,7 @@ void Searcher::fill_assumptions_set_from(const vector<AssumptionPair>& fill_from
             if (value(lit) == l_Undef) {
                 std::cerr
                 << "ERROR: Lit " << lit
-                << " varData[lit.var()].removed: " << removed_type_to_string(varData[lit.var()].removed)
+                << " varDataCold[lit.var()].removed: " << removed_type_to_string(varDataCold[lit.var()].removed)
                 << " value: " << value(lit)
                 << " -- value should NOT be l_Undef"
                 << endl;
@@ -3000,6 +3288,9 @@ Searcher::Stats& Searcher::Stats::operator+=(const Stats& other)
     stampShrinkLit += other.stampShrinkLit;
     moreMinimLitsStart += other.moreMinimLitsStart;
     moreMinimLitsEnd += other.moreMinimLitsEnd;
+    binGraphShrinkCl += other.binGraphShrinkCl;
+    binGraphShrinkLit += other.binGraphShrinkLit;
+    binGraphShrinkTime += other.binGraphShrinkTime;
     recMinimCost += other.recMinimCost;
 
     //Red stats
@@ -3012,6 +3303,10 @@ Searcher::Stats& Searcher::Stats::operator+=(const Stats& other)
     otfSubsumedLong += other.otfSubsumedLong;
     otfSubsumedRed += other.otfSubsumedRed;
     otfSubsumedLitsGained += other.otfSubsumedLitsGained;
+    chronoBacktrack += other.chronoBacktrack;
+    chronoTrailKept += other.chronoTrailKept;
+    chronoReenqueued += other.chronoReenqueued;
+    chronoMissedImpl += other.chronoMissedImpl;
 
     //Hyper-bin & transitive reduction
     advancedPropCalled += other.advancedPropCalled;
@@ -3057,6 +3352,9 @@ Searcher::Stats& Searcher::Stats::operator-=(const Stats& other)
     stampShrinkLit -= other.stampShrinkLit;
     moreMinimLitsStart -= other.moreMinimLitsStart;
     moreMinimLitsEnd -= other.moreMinimLitsEnd;
+    binGraphShrinkCl -= other.binGraphShrinkCl;
+    binGraphShrinkLit -= other.binGraphShrinkLit;
+    binGraphShrinkTime -= other.binGraphShrinkTime;
     recMinimCost -= other.recMinimCost;
 
     //Red stats
@@ -3069,6 +3367,10 @@ Searcher::Stats& Searcher::Stats::operator-=(const Stats& other)
     otfSubsumedLong -= other.otfSubsumedLong;
     otfSubsumedRed -= other.otfSubsumedRed;
     otfSubsumedLitsGained -= other.otfSubsumedLitsGained;
+    chronoBacktrack -= other.chronoBacktrack;
+    chronoTrailKept -= other.chronoTrailKept;
+    chronoReenqueued -= other.chronoReenqueued;
+    chronoMissedImpl -= other.chronoMissedImpl;
 
     //Hyper-bin & transitive reduction
     advancedPropCalled -= other.advancedPropCalled;
@@ -3195,6 +3497,30 @@ void Searcher::Stats::print() const
         , "lits/otf subsume"
     );
 
+    print_stats_line("c chrono backtracks"
+        , chronoBacktrack
+        , stats_line_percent(chronoBacktrack, conflStats.numConflicts)
+        , "% of conflicts"
+    );
+
+    print_stats_line("c chrono trail kept"
+        , chronoTrailKept
+        , ratio_for_stat(chronoTrailKept, chronoBacktrack)
+        , "lits/chrono backtrack"
+    );
+
+    print_stats_line("c chrono re-enqueued"
+        , chronoReenqueued
+        , stats_line_percent(chronoReenqueued, chronoTrailKept)
+        , "% of trail kept"
+    );
+
+    print_stats_line("c chrono missed implications"
+        , chronoMissedImpl
+        , stats_line_percent(chronoMissedImpl, conflStats.numConflicts)
+        , "% of conflicts"
+    );
+
     cout << "c SEAMLESS HYPERBIN&TRANS-RED stats" << endl;
     print_stats_line("c advProp called"
         , advancedPropCalled
@@ -3252,6 +3578,18 @@ void Searcher::Stats::print() const
         , "% less overall"
     );
 
+    print_stats_line("c bingraph-min lits"
+        , binGraphShrinkLit
+        , stats_line_percent(binGraphShrinkLit, litsRedNonMin)
+        , "% less overall"
+    );
+
+    print_stats_line("c bingraph-min lits/us"
+        , ratio_for_stat(binGraphShrinkLit, binGraphShrinkTime*1000.0*1000.0)
+        , stats_line_percent(binGraphShrinkCl, conflStats.numConflicts)
+        , "% of clauses shrunk"
+    );
+
     print_stats_line("c stamp-min call%"
         , stats_line_percent(stampShrinkAttempt, conflStats.numConflicts)
         , stats_line_percent(stampShrinkCl, stampShrinkAttempt)
@@ -3324,7 +3662,7 @@ void Searcher::read_long_cls(
             f.get_struct(stats);
         }
 
-        Clause* cl = cl_alloc.Clause_new(tmp_cl, 0);
+        Clause* cl = cl_alloc.Clause_new(tmp_cl, 0, red);
         if (red) {
             cl->makeRed(stats.glue);
         }
@@ -3452,7 +3790,7 @@ void Searcher::load_state(SimpleInFile& f, const lbool status)
 
     f.get_vector(activities);
     for(size_t i = 0; i < nVars(); i++) {
-        if (varData[i].removed == Removed::none
+        if (varDataCold[i].removed == Removed::none
             && value(i) == l_Undef
         ) {
             insertVarOrder(i);
@@ -251,6 +251,9 @@ class Searcher : public HyperEngine
             uint64_t stampShrinkLit = 0;
             uint64_t moreMinimLitsStart = 0;
             uint64_t moreMinimLitsEnd = 0;
+            uint64_t binGraphShrinkCl = 0;
+            uint64_t binGraphShrinkLit = 0;
+            double   binGraphShrinkTime = 0;
             uint64_t recMinimCost = 0;
 
             //Learnt clause stats
@@ -264,6 +267,12 @@ class Searcher : public HyperEngine
             uint64_t otfSubsumedRed = 0;
             uint64_t otfSubsumedLitsGained = 0;
 
+            //Chronological backtracking
+            uint64_t chronoBacktrack = 0;
+            uint64_t chronoTrailKept = 0; ///<Literals a backjump would have unset and propagated again
+            uint64_t chronoReenqueued = 0; ///<Literals below the backtrack level put back on the trail
+            uint64_t chronoMissedImpl = 0;
+
             //Hyper-bin & transitive reduction
             uint64_t advancedPropCalled = 0;
             uint64_t hyperBinAdded = 0;
@@ -377,10 +386,13 @@ class Searcher : public HyperEngine
         /// Search for a given number of conflicts.
         bool last_decision_ended_in_conflict;
         lbool search();
+        lbool search_with_front_bins();
         lbool burst_search();
         bool  handle_conflict(PropBy confl);// Handles the conflict clause
+        lbool backtrack_to_conflict_level(const PropBy confl);
+        bool  chrono_backtrack_allowed() const;
         void  update_history_stats(size_t backtrack_level, size_t glue);
-        void  attach_and_enqueue_learnt_clause(Clause* cl);
+        void  attach_and_enqueue_learnt_clause(Clause* cl, const uint32_t glue, const uint32_t backtrack_level);
         void  print_learning_debug_info() const;
         void  print_learnt_clause() const;
         void  add_otf_subsume_long_clauses();
@@ -489,6 +501,7 @@ class Searcher : public HyperEngine
         uint32_t num_search_called = 0;
 
         bool must_consolidate_mem = false;
+        bool must_distill_red = false;
         void print_solution_varreplace_status() const;
         void dump_search_sql(const double myTime);
         void rearrange_clauses_watches();
@@ -498,6 +511,10 @@ class Searcher : public HyperEngine
         // Transitive on-the-fly self-subsuming resolution
         void   minimise_redundant_more(vector<Lit>& cl);
         void   binary_based_more_minim(vector<Lit>& cl);
+        void   binary_graph_more_minim(vector<Lit>& cl);
+        vector<uint64_t> bin_graph_visited; ///<One bit per literal, reached by the current walk
+        vector<Lit> bin_graph_visited_lits;
+        vector<Lit> bin_graph_stack;
         void   cache_based_more_minim(vector<Lit>& cl);
         void   stamp_based_more_minim(vector<Lit>& cl);
 
@@ -601,7 +618,27 @@ inline void Searcher::cancelUntil(uint32_t level)
     cout << endl;
     #endif
 
-    if (decisionLevel() > level) {
+    if (decisionLevel() > level && chrono_backtrack_allowed()) {
+        //The trail may be out of order. Literals set at or below 'level'
+        //stay, in order, and are propagated again
+        uint32_t j = trail_lim[level];
+        for (uint32_t i = trail_lim[level]; i < trail.size(); i++) {
+            const Lit lit = trail[i];
+            if (varData[lit.var()].level <= level) {
+                trail[j++] = lit;
+                continue;
+            }
+
+            assigns[lit.var()] = l_Undef;
+            if (also_insert_varorder) {
+                insertVarOrder(lit.var());
+            }
+        }
+        stats.chronoReenqueued += j - trail_lim[level];
+        qhead = trail_lim[level];
+        trail.resize(j);
+        trail_lim.resize(level);
+    } else if (decisionLevel() > level) {
 
         //Go through in reverse order, unassign & insert then
         //back to the vars to be branched upon
@@ -640,13 +677,19 @@ inline void Searcher::cancelUntil(uint32_t level)
     #endif
 }
 
+inline bool Searcher::chrono_backtrack_allowed() const
+{
+    //The assumptions must stay at their own levels
+    return conf.chrono_backtrack >= 0 && assumptions.empty();
+}
+
 inline void Searcher::insertVarOrder(const Var x)
 {
     if (!order_heap.in_heap(x)
     ) {
         #ifdef SLOW_DEUG
         //All active varibles are decision variables
-        assert(varData[x].removed == Removed::none);
+        assert(varDataCold[x].removed == Removed::none);
         #endif
 
         order_heap.insert(x);
@@ -689,13 +732,13 @@ inline bool Searcher::check_order_heap_sanity() const
 {
     for(size_t i = 0; i < nVars(); i++)
     {
-        if (varData[i].removed == Removed::none
+        if (varDataCold[i].removed == Removed::none
             && value(i) == l_Undef)
         {
             if (!order_heap.in_heap(i)) {
                 cout << "ERROR var " << i+1 << " not in heap."
                 << " value: " << value(i)
-                << " removed: " << removed_type_to_string(varData[i].removed)
+                << " removed: " << removed_type_to_string(varDataCold[i].removed)
                 << endl;
                 return false;
             }
@@ -25,66 +25,275 @@
 #include "cryptominisat4/solvertypesmini.h"
 
 #include <vector>
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <limits>
+#include <cassert>
 using std::vector;
-using std::mutex;
 
 namespace CMSat {
 
-class SharedData
+/**
+@brief Single-producer, multi-consumer ring of clauses to share
+
+Only the owning thread pushes, any thread may read, and nobody ever takes a
+lock. Readers each keep their own position. The writer never waits for
+readers: if a reader falls behind by more than the size of the ring, the
+clauses it missed are simply lost. Every slot carries a sequence number
+(odd while being written) so that a reader can detect a slot that was
+overwritten under it, seqlock-style.
+*/
+class ClauseRing
 {
     public:
-        SharedData(const uint32_t _num_threads) :
-            num_threads(_num_threads)
-        {}
+        //Slots are exactly one cache line
+        static const uint32_t max_cl_size = 12;
 
-        struct Spec {
-            Spec() :
-                data(new vector<Lit>)
-            {}
-
-            Spec(const Spec&) {
-                assert(false);
+        explicit ClauseRing(const uint32_t size_log2) :
+            mask((1ULL << size_log2) - 1)
+            , slots(new Slot[mask+1])
+        {
+            for(uint64_t i = 0; i <= mask; i++) {
+                slots[i].seq.store(0, std::memory_order_relaxed);
             }
-            Spec(Spec&& other)
-            #ifndef _MSC_VER
-            noexcept
-            #endif
-            :
-                data(std::move(other.data))
-            {
-                other.data = NULL;
+            head.store(0, std::memory_order_release);
+        }
+
+        ~ClauseRing()
+        {
+            delete[] slots;
+        }
+
+        ClauseRing(const ClauseRing&) = delete;
+        ClauseRing& operator=(const ClauseRing&) = delete;
+
+        //Must only be called by the thread owning the ring
+        void push(const vector<Lit>& lits, const uint32_t glue)
+        {
+            assert(!lits.empty() && lits.size() <= max_cl_size);
+            const uint64_t pos = head.load(std::memory_order_relaxed);
+            Slot& s = slots[pos & mask];
+
+            s.seq.store(2*pos+1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            s.size.store(lits.size(), std::memory_order_relaxed);
+            s.glue.store(glue, std::memory_order_relaxed);
+            for(size_t i = 0; i < lits.size(); i++) {
+                s.lits[i].store(lits[i].toInt(), std::memory_order_relaxed);
             }
-            ~Spec() {
-                clear();
+            s.seq.store(2*pos+2, std::memory_order_release);
+            head.store(pos+1, std::memory_order_release);
+        }
+
+        /**
+        @brief Calls func(lits, glue) for every clause pushed since 'pos'
+
+        Updates 'pos' and adds the number of clauses that were overwritten
+        before they could be read to 'lost'. Stops early (and returns FALSE)
+        if func returns FALSE.
+        */
+        template<class Function>
+        bool read_new(
+            uint64_t& pos
+            , vector<Lit>& tmp
+            , uint64_t& lost
+            , Function func
+        ) const {
+            const uint64_t h = head.load(std::memory_order_acquire);
+            if (h - pos > mask+1) {
+                lost += h - pos - (mask+1);
+                pos = h - (mask+1);
             }
-            vector<Lit>* data = NULL;
 
-            void clear()
-            {
-                delete data;
-                data = NULL;
+            for(; pos < h; pos++) {
+                const Slot& s = slots[pos & mask];
+                const uint64_t seq = s.seq.load(std::memory_order_acquire);
+                if (seq != 2*pos+2) {
+                    lost++;
+                    continue;
+                }
+
+                uint32_t size = s.size.load(std::memory_order_relaxed);
+                if (size > max_cl_size) {
+                    size = max_cl_size;
+                }
+                const uint32_t glue = s.glue.load(std::memory_order_relaxed);
+                tmp.clear();
+                for(uint32_t i = 0; i < size; i++) {
+                    tmp.push_back(Lit::toLit(s.lits[i].load(std::memory_order_relaxed)));
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (s.seq.load(std::memory_order_relaxed) != seq) {
+                    lost++;
+                    continue;
+                }
+
+                if (!func(tmp, glue)) {
+                    pos++;
+                    return false;
+                }
             }
+
+            return true;
+        }
+
+        uint64_t get_head() const
+        {
+            return head.load(std::memory_order_acquire);
+        }
+
+        size_t mem_used() const
+        {
+            return (mask+1)*sizeof(Slot);
+        }
+
+    private:
+        struct Slot {
+            //2*pos+1 while being written, 2*pos+2 once 'pos' is complete
+            std::atomic<uint64_t> seq;
+            std::atomic<uint32_t> size;
+            std::atomic<uint32_t> glue;
+            std::atomic<uint32_t> lits[max_cl_size];
         };
-        vector<lbool> value;
-        vector<Spec> bins;
-        mutex unit_mutex;
-        mutex bin_mutex;
 
+        const uint64_t mask;
+        Slot* slots;
+        std::atomic<uint64_t> head;
+};
+
+class SharedData
+{
+    public:
+        SharedData(const uint32_t _num_threads, const uint32_t ring_size_log2) :
+            wanted_glue(_num_threads)
+            , num_threads(_num_threads)
+        {
+            for(uint32_t i = 0; i < num_threads; i++) {
+                rings.push_back(new ClauseRing(ring_size_log2));
+            }
+            det_reset();
+        }
+
+        ~SharedData()
+        {
+            for(ClauseRing* ring: rings) {
+                delete ring;
+            }
+        }
+
+        SharedData(const SharedData&) = delete;
+        SharedData& operator=(const SharedData&) = delete;
+
+        //One per thread, clauses are in outside numbering
+        vector<ClauseRing*> rings;
+
+        //Max glue of long clauses each thread wants to receive
+        vector<std::atomic<uint32_t> > wanted_glue;
         uint32_t num_threads;
 
-        size_t calc_memory_use_bins()
+        /**
+        @brief Deterministic mode: threads only exchange clauses at barriers
+
+        Each solve() call is made up of rounds. Every thread decides on its own
+        (by counting its propagations) when it has finished the current round
+        and then waits in det_wait() until all threads that are still solving
+        have done the same. A thread that finishes must call det_finish(), so
+        it does not hold up the others. The winner is the thread that finished
+        in the earliest round, ties broken by thread number.
+        */
+        void det_reset()
         {
-            size_t mem = 0;
-            mem += bins.capacity()*sizeof(Spec);
-            for(size_t i = 0; i < bins.size(); i++) {
-                if (bins[i].data) {
-                    mem += bins[i].data->capacity()*sizeof(Lit);
-                    mem += sizeof(vector<Lit>);
+            std::lock_guard<std::mutex> lock(det_mutex);
+            det_solve_num++;
+            det_active = num_threads;
+            det_waiting = 0;
+            det_first_finish_round = std::numeric_limits<uint64_t>::max();
+            det_finish_round.assign(num_threads, std::numeric_limits<uint64_t>::max());
+            det_result.assign(num_threads, l_Undef);
+        }
+
+        void det_wait()
+        {
+            std::unique_lock<std::mutex> lock(det_mutex);
+            const uint64_t gen = det_generation;
+            det_waiting++;
+            if (det_waiting == det_active) {
+                det_release();
+            } else {
+                det_cv.wait(lock, [&]{ return det_generation != gen; });
+            }
+        }
+
+        void det_finish(const uint32_t thread_num, const uint64_t round, const lbool ret)
+        {
+            std::lock_guard<std::mutex> lock(det_mutex);
+            if (ret != l_Undef) {
+                det_result[thread_num] = ret;
+                det_finish_round[thread_num] = round;
+                det_first_finish_round = std::min(det_first_finish_round, round);
+            }
+            assert(det_active > 0);
+            det_active--;
+            if (det_waiting > 0 && det_waiting == det_active) {
+                det_release();
+            }
+        }
+
+        //Somebody finished in a round before 'round'
+        bool det_must_stop(const uint64_t round)
+        {
+            std::lock_guard<std::mutex> lock(det_mutex);
+            return det_first_finish_round < round;
+        }
+
+        uint64_t det_get_solve_num()
+        {
+            std::lock_guard<std::mutex> lock(det_mutex);
+            return det_solve_num;
+        }
+
+        //Only call once all threads have finished
+        lbool det_winner(int& which_solved) const
+        {
+            lbool ret = l_Undef;
+            uint64_t best_round = std::numeric_limits<uint64_t>::max();
+            for(uint32_t i = 0; i < num_threads; i++) {
+                if (det_result[i] != l_Undef && det_finish_round[i] < best_round) {
+                    best_round = det_finish_round[i];
+                    which_solved = i;
+                    ret = det_result[i];
                 }
             }
+            return ret;
+        }
+
+        size_t calc_memory_use() const
+        {
+            size_t mem = 0;
+            for(const ClauseRing* ring: rings) {
+                mem += ring->mem_used();
+            }
             return mem;
         }
+
+    private:
+        void det_release()
+        {
+            det_waiting = 0;
+            det_generation++;
+            det_cv.notify_all();
+        }
+
+        std::mutex det_mutex;
+        std::condition_variable det_cv;
+        uint64_t det_solve_num = 0;
+        uint64_t det_generation = 0;
+        uint32_t det_active;
+        uint32_t det_waiting;
+        uint64_t det_first_finish_round;
+        vector<uint64_t> det_finish_round;
+        vector<lbool> det_result;
 };
 
 }
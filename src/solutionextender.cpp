@@ -75,7 +75,7 @@ void SolutionExtender::dummyBlocked(const Lit blockedOn)
     #endif
 
     const Var blockedOn_inter = solver->map_outer_to_inter(blockedOn.var());
-    assert(solver->varData[blockedOn_inter].removed == Removed::elimed);
+    assert(solver->varDataCold[blockedOn_inter].removed == Removed::elimed);
 
     //Oher blocked clauses set its value already
     if (solver->model_value(blockedOn) != l_Undef)
@@ -93,7 +93,7 @@ void SolutionExtender::dummyBlocked(const Lit blockedOn)
 void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
 {
     const Var blocked_on_inter = solver->map_outer_to_inter(blockedOn.var());
-    assert(solver->varData[blocked_on_inter].removed == Removed::elimed);
+    assert(solver->varDataCold[blocked_on_inter].removed == Removed::elimed);
     assert(contains_lit(lits, blockedOn));
     if (satisfied(lits))
         return;
@@ -103,7 +103,7 @@ void SolutionExtender::addClause(const vector<Lit>& lits, const Lit blockedOn)
         Lit lit_inter = solver->map_outer_to_inter(lit);
         cout
         << lit << ": " << solver->model_value(lit)
-        << "(elim: " << removed_type_to_string(solver->varData[lit_inter.var()].removed) << ")"
+        << "(elim: " << removed_type_to_string(solver->varDataCold[lit_inter.var()].removed) << ")"
         << ", ";
     }
     cout << "blocked on: " <<  blockedOn << endl;
@@ -192,10 +192,10 @@ void Solver::parse_sql_option()
     }
 }
 
-void Solver::set_shared_data(SharedData* shared_data)
+void Solver::set_shared_data(SharedData* shared_data, uint32_t thread_num)
 {
     delete datasync;
-    datasync = new DataSync(this, shared_data);
+    datasync = new DataSync(this, shared_data, thread_num);
 }
 
 bool Solver::add_xor_clause_inter(
@@ -235,7 +235,7 @@ bool Solver::add_xor_clause_inter(
             //Add and remember as last one to have been added
             ps[j++] = p = ps[i];
 
-            assert(varData[p.var()].removed != Removed::elimed);
+            assert(varDataCold[p.var()].removed != Removed::elimed);
         } else {
             //modify rhs instead of adding
             assert(value(ps[i]) != l_Undef);
@@ -244,7 +244,7 @@ bool Solver::add_xor_clause_inter(
     }
     ps.resize(ps.size() - (i - j));
 
-    if (ps.size() > (0x01UL << 18)) {
+    if (ps.size() > (0x01UL << 28)) {
         cout << "Too long clause!" << endl;
         std::exit(-1);
     }
@@ -367,10 +367,10 @@ bool Solver::sort_and_clean_clause(vector<Lit>& ps, const vector<Lit>& origCl)
         else if (value(ps[i]) != l_False && ps[i] != p) {
             ps[j++] = p = ps[i];
 
-            if (varData[p.var()].removed != Removed::none) {
+            if (varDataCold[p.var()].removed != Removed::none) {
                 cout << "ERROR: clause " << origCl << " contains literal "
                 << p << " whose variable has been removed (removal type: "
-                << removed_type_to_string(varData[p.var()].removed)
+                << removed_type_to_string(varDataCold[p.var()].removed)
                 << " var-updated lit: "
                 << varReplacer->get_var_replaced_with(p)
                 << ")"
@@ -379,7 +379,7 @@ bool Solver::sort_and_clean_clause(vector<Lit>& ps, const vector<Lit>& origCl)
 
             //Variables that have been eliminated cannot be added internally
             //as part of a clause. That's a bug
-            assert(varData[p.var()].removed == Removed::none);
+            assert(varDataCold[p.var()].removed == Removed::none);
         }
     }
     ps.resize(ps.size() - (i - j));
@@ -478,7 +478,7 @@ Clause* Solver::add_clause_int(
             return NULL;
 
         default:
-            Clause* c = cl_alloc.Clause_new(ps, sumStats.conflStats.numConflicts);
+            Clause* c = cl_alloc.Clause_new(ps, sumStats.conflStats.numConflicts, red);
             if (red)
                 c->makeRed(stats.glue);
             c->stats = stats;
@@ -639,7 +639,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     assert(qhead == trail.size());
 
     //Check for too long clauses
-    if (ps.size() > (0x01UL << 18)) {
+    if (ps.size() > (0x01UL << 28)) {
         cout << "Too long clause!" << endl;
         std::exit(-1);
     }
@@ -690,7 +690,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     if (compHandler) {
         bool readd = false;
         for (Lit lit: ps) {
-            if (varData[lit.var()].removed == Removed::decomposed) {
+            if (varDataCold[lit.var()].removed == Removed::decomposed) {
                 readd = true;
                 break;
             }
@@ -704,7 +704,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     //Uneliminate vars
     for (const Lit lit: ps) {
         if (conf.perform_occur_based_simp
-            && varData[lit.var()].removed == Removed::elimed
+            && varDataCold[lit.var()].removed == Removed::elimed
         ) {
             #ifdef VERBOSE_DEBUG_RECONSTRUCT
             cout << "Uneliminating var " << lit.var() + 1 << endl;
@@ -725,7 +725,7 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
     return true;
 }
 
-bool Solver::addClause(const vector<Lit>& lits)
+void Solver::check_no_blocked_clauses() const
 {
     if (conf.perform_occur_based_simp && simplifier->getAnythingHasBeenBlocked()) {
         std::cerr
@@ -734,6 +734,11 @@ bool Solver::addClause(const vector<Lit>& lits)
         << endl;
         std::exit(-1);
     }
+}
+
+bool Solver::addClause(const vector<Lit>& lits, LoadedClauses* loaded)
+{
+    check_no_blocked_clauses();
 
     #ifdef VERBOSE_DEBUG
     cout << "Adding clause " << lits << endl;
@@ -777,12 +782,174 @@ bool Solver::addClause(const vector<Lit>& lits)
         ClOffset offset = cl_alloc.get_offset(cl);
         longIrredCls.push_back(offset);
     }
+    record_loaded_clause(cl, loaded);
+
+    zeroLevAssignsByCNF += trail.size() - origTrailSize;
+
+    return ok;
+}
+
+void Solver::record_loaded_clause(const Clause* cl, LoadedClauses* loaded) const
+{
+    if (loaded) {
+        switch(finalCl_tmp.size()) {
+            case 0:
+                //Satisfied, or UNSAT, which the caller checks
+                break;
+            case 1:
+                loaded->units.push_back(finalCl_tmp[0]);
+                break;
+            case 2:
+                loaded->bins.insert(loaded->bins.end(), finalCl_tmp.begin(), finalCl_tmp.end());
+                break;
+            case 3:
+                loaded->tris.insert(loaded->tris.end(), finalCl_tmp.begin(), finalCl_tmp.end());
+                break;
+            default:
+                loaded->longs.push_back(cl_alloc.get_offset(cl));
+                break;
+        }
+    }
+}
+
+/**
+@brief Adds a batch of clauses, each terminated by lit_Undef
+
+Lits after the last lit_Undef form one more clause. The same as calling
+addClause() on each of them, but without building a vector per clause in the
+caller, and with the DRUP lines of the whole batch written at its end: all
+additions first, then the deletion of all the clauses that got changed.
+*/
+bool Solver::add_clauses_outer(
+    const Lit* lits
+    , const size_t num_lits
+    , LoadedClauses* loaded
+) {
+    if (!ok) {
+        return false;
+    }
+    check_no_blocked_clauses();
+    const size_t origTrailSize = trail.size();
+
+    vector<Lit>& ps = add_clauses_tmp;
+    vector<Lit> drup_deleted;
+    const Lit* const end = lits + num_lits;
+    for(const Lit* at = lits; at != end && ok;) {
+        ps.clear();
+        for(; at != end && *at != lit_Undef; at++) {
+            ps.push_back(*at);
+        }
+        if (at != end) {
+            at++;
+        }
+
+        check_too_large_variable_number(ps);
+        for(Lit& lit: ps) {
+            lit = map_to_with_bva(lit);
+        }
+        if (!addClauseHelper(ps)) {
+            break;
+        }
+
+        finalCl_tmp.clear();
+        std::sort(ps.begin(), ps.end());
+        Clause* cl = add_clause_int(
+            ps
+            , false //irred
+            , ClauseStats() //default stats
+            , true //yes, attach
+            , &finalCl_tmp
+            , false
+        );
+
+        if (drup->enabled() && ps != finalCl_tmp) {
+            if (!finalCl_tmp.empty()) {
+                *drup << finalCl_tmp << fin;
+            }
+            drup_deleted.insert(drup_deleted.end(), ps.begin(), ps.end());
+            drup_deleted.push_back(lit_Undef);
+        }
+
+        if (cl != NULL) {
+            longIrredCls.push_back(cl_alloc.get_offset(cl));
+        }
+        record_loaded_clause(cl, loaded);
+    }
+
+    if (!drup_deleted.empty()) {
+        //Empty clause, it's UNSAT
+        if (!okay()) {
+            *drup << fin;
+        }
+
+        vector<Lit> cl;
+        for(const Lit lit: drup_deleted) {
+            if (lit == lit_Undef) {
+                *drup << del << cl << fin;
+                cl.clear();
+            } else {
+                cl.push_back(lit);
+            }
+        }
+    }
 
     zeroLevAssignsByCNF += trail.size() - origTrailSize;
 
     return ok;
 }
 
+/**
+@brief Adds the clauses another Solver stored while loading a batch
+
+Both Solvers must have been in the same state before the batch, so the
+clauses need no renumbering or cleaning: long clauses are simply copied over
+from the other Solver's allocator, or, if the allocators share their memory,
+used in place. Units are propagated only after all clauses have been attached,
+which gives the same level 0 assignment as propagating them one by one.
+*/
+bool Solver::clone_loaded_clauses(
+    const Solver& from
+    , const LoadedClauses& loaded
+    , const bool arena_shared
+) {
+    if (!ok) {
+        return false;
+    }
+    if (!from.okay()) {
+        ok = false;
+        return false;
+    }
+    assert(decisionLevel() == 0);
+    assert(nVars() == from.nVars());
+    const size_t origTrailSize = trail.size();
+
+    for(size_t i = 0; i < loaded.bins.size(); i += 2) {
+        attach_bin_clause(loaded.bins[i], loaded.bins[i+1], false);
+    }
+    for(size_t i = 0; i < loaded.tris.size(); i += 3) {
+        attach_tri_clause(loaded.tris[i], loaded.tris[i+1], loaded.tris[i+2], false);
+    }
+    for(const ClOffset offset: loaded.longs) {
+        if (arena_shared) {
+            attachClause(*cl_alloc.ptr(offset));
+            longIrredCls.push_back(offset);
+        } else {
+            Clause* cl = cl_alloc.Clause_new(*from.cl_alloc.ptr(offset));
+            attachClause(*cl);
+            longIrredCls.push_back(cl_alloc.get_offset(cl));
+        }
+    }
+    for(const Lit lit: loaded.units) {
+        if (value(lit) == l_Undef) {
+            enqueue(lit);
+        }
+    }
+    ok = propagate<true>().isNULL();
+    zeroLevAssignsByCNF += trail.size() - origTrailSize;
+
+    return ok;
+}
+
 /*bool Solver::addRedClause(
     const vector<Lit>& lits
     , const ClauseStats& stats
@@ -814,9 +981,9 @@ void Solver::test_renumbering() const
         if (value(i)  != l_Undef)
             uninteresting = true;
 
-        if (varData[i].removed == Removed::elimed
-            || varData[i].removed == Removed::replaced
-            || varData[i].removed == Removed::decomposed
+        if (varDataCold[i].removed == Removed::elimed
+            || varDataCold[i].removed == Removed::replaced
+            || varDataCold[i].removed == Removed::decomposed
         ) {
             uninteresting = true;
             //cout << " removed" << endl;
@@ -825,9 +992,9 @@ void Solver::test_renumbering() const
         }
 
         if (value(i) == l_Undef
-            && varData[i].removed != Removed::elimed
-            && varData[i].removed != Removed::replaced
-            && varData[i].removed != Removed::decomposed
+            && varDataCold[i].removed != Removed::elimed
+            && varDataCold[i].removed != Removed::replaced
+            && varDataCold[i].removed != Removed::decomposed
             && uninteresting
         ) {
             problem = true;
@@ -859,13 +1026,41 @@ size_t Solver::calculate_interToOuter_and_outerToInter(
     size_t at = 0;
     vector<Var> useless;
     size_t numEffectiveVars = 0;
+    vector<char> numbered(nVars(), 0);
     for(size_t i = 0; i < nVars(); i++) {
         if (value(i) != l_Undef
-            || varData[i].removed == Removed::elimed
-            || varData[i].removed == Removed::replaced
-            || varData[i].removed == Removed::decomposed
+            || varDataCold[i].removed == Removed::elimed
+            || varDataCold[i].removed == Removed::replaced
+            || varDataCold[i].removed == Removed::decomposed
         ) {
             useless.push_back(i);
+            numbered[i] = 1;
+        }
+    }
+
+    //Variables of the same clause get numbers close to each other, so their
+    //varData, assigns, seen and watchlists share cache lines and pages
+    if (conf.renumber_by_occur) {
+        for(const ClOffset offs: longIrredCls) {
+            const Clause& cl = *cl_alloc.ptr(offs);
+            for(const Lit lit: cl) {
+                const Var var = lit.var();
+                if (numbered[var]) {
+                    continue;
+                }
+
+                numbered[var] = 1;
+                outerToInter[var] = at;
+                interToOuter[at] = var;
+                at++;
+                numEffectiveVars++;
+            }
+        }
+    }
+
+    //The rest of the useful variables keep their order
+    for(size_t i = 0; i < nVars(); i++) {
+        if (numbered[i]) {
             continue;
         }
 
@@ -1768,6 +1963,11 @@ lbool Solver::simplify_problem(const bool startup)
 
     //Free unused watch memory
     free_unused_watches();
+
+    //Simplification frees mostly irredundant clauses, compact the old slabs
+    if (ok) {
+        cl_alloc.consolidate(this);
+    }
     //addSymmBreakClauses();
 
     //Re-calculate reachability after re-numbering and new cache data
@@ -1917,6 +2117,11 @@ void Solver::print_min_stats() const
     print_stats_line("c props/conflict"
         , (double)propStats.propagations/(double)sumStats.conflStats.numConflicts
     );
+    print_stats_line("c search Mprops"
+        , (double)sumPropStats.propagations/(1000.0*1000.0)
+        , ratio_for_stat(sumPropStats.propagations, sumStats.cpu_time*1000.0*1000.0)
+        , "/ search sec"
+    );
 
     print_stats_line("c 0-depth assigns", trail.size()
         , stats_line_percent(trail.size(), nVars())
@@ -1952,6 +2157,11 @@ void Solver::print_min_stats() const
                     , stats_line_percent(distiller->get_stats().time_used, cpu_time)
                     , "% time"
     );
+    print_stats_line("c distill red time"
+                    , distiller->get_red_stats().time_used
+                    , stats_line_percent(distiller->get_red_stats().time_used, cpu_time)
+                    , "% time"
+    );
     print_stats_line("c strength cache-irred time"
                     , distillerwithbin->get_stats().irredCacheBased.cpu_time
                     , stats_line_percent(distillerwithbin->get_stats().irredCacheBased.cpu_time, cpu_time)
@@ -1984,6 +2194,11 @@ void Solver::print_norm_stats() const
     print_stats_line("c props/conflict"
         , (double)propStats.propagations/(double)sumStats.conflStats.numConflicts
     );
+    print_stats_line("c search Mprops"
+        , (double)sumPropStats.propagations/(1000.0*1000.0)
+        , ratio_for_stat(sumPropStats.propagations, sumStats.cpu_time*1000.0*1000.0)
+        , "/ search sec"
+    );
 
     print_stats_line("c 0-depth assigns", trail.size()
         , stats_line_percent(trail.size(), nVars())
@@ -1999,6 +2214,9 @@ void Solver::print_norm_stats() const
         , stats_line_percent(zeroLevAssignsByCNF, nVars())
         , "% vars"
     );
+    if (datasync->enabled()) {
+        datasync->get_stats().print();
+    }
 
     //Failed lit stats
     if (conf.doProbe) {
@@ -2033,6 +2251,11 @@ void Solver::print_norm_stats() const
                     , stats_line_percent(distiller->get_stats().time_used, cpu_time)
                     , "% time"
     );
+    print_stats_line("c distill red time"
+                    , distiller->get_red_stats().time_used
+                    , stats_line_percent(distiller->get_red_stats().time_used, cpu_time)
+                    , "% time"
+    );
     print_stats_line("c strength cache-irred time"
                     , distillerwithbin->get_stats().irredCacheBased.cpu_time
                     , stats_line_percent(distillerwithbin->get_stats().irredCacheBased.cpu_time, cpu_time)
@@ -2094,6 +2317,9 @@ void Solver::print_all_stats() const
         , stats_line_percent(zeroLevAssignsByCNF, nVars())
         , "% vars"
     );
+    if (datasync->enabled()) {
+        datasync->get_stats().print();
+    }
 
     //Failed lit stats
     if (conf.doProbe) {
@@ -2152,6 +2378,11 @@ void Solver::print_all_stats() const
                     , stats_line_percent(distiller->get_stats().time_used, cpu_time)
                     , "% time");
     distiller->get_stats().print(nVars());
+    print_stats_line("c distill red time"
+                    , distiller->get_red_stats().time_used
+                    , stats_line_percent(distiller->get_red_stats().time_used, cpu_time)
+                    , "% time");
+    distiller->get_red_stats().print(nVars());
 
     print_stats_line("c strength cache-irred time"
                     , distillerwithbin->get_stats().irredCacheBased.cpu_time
@@ -2198,6 +2429,9 @@ uint64_t Solver::print_watch_mem_used(const uint64_t rss_mem_used) const
         , stats_line_percent(array, rss_mem_used)
         , "%"
     );
+    HugePages::PageStats pages;
+    watches.count_pages(pages);
+    pages.print("watches");
 
     return alloc + array;
 }
@@ -2217,6 +2451,7 @@ uint64_t Solver::mem_used_vardata() const
     uint64_t mem = 0;
     mem += assigns.capacity()*sizeof(lbool);
     mem += varData.capacity()*sizeof(VarData);
+    mem += varDataCold.capacity()*sizeof(VarDataCold);
 
     return mem;
 }
@@ -2395,14 +2630,14 @@ vector<Lit> Solver::get_zero_assigned_lits() const
 
             //Update to higher-up
             lit = varReplacer->get_lit_replaced_with(lit);
-            if (varData[lit.var()].is_bva == false) {
+            if (varDataCold[lit.var()].is_bva == false) {
                 lits.push_back(map_inter_to_outer(lit));
             }
 
             //Everything it repaces has also been set
             const vector<Var> vars = varReplacer->get_vars_replacing(lit.var());
             for(const Var var: vars) {
-                if (varData[var].is_bva)
+                if (varDataCold[var].is_bva)
                     continue;
 
                 Lit tmp_lit = Lit(var, false);
@@ -2434,6 +2669,36 @@ vector<Lit> Solver::get_zero_assigned_lits() const
     return lits;
 }
 
+//Some literal of the cube (in outside numbering) is already false at
+//decision level 0, e.g. because of a unit received from another thread
+bool Solver::cube_refuted_at_zero(const vector<Lit>& cube) const
+{
+    assert(decisionLevel() == 0);
+    for(Lit lit: cube) {
+        assert(lit.var() < nVarsOutside());
+        lit = map_to_with_bva(lit);
+        lit = varReplacer->get_lit_replaced_with_outer(lit);
+        lit = map_outer_to_inter(lit);
+        if (lit.var() < nVars()
+            && varDataCold[lit.var()].removed == Removed::none
+            && value(lit) == l_False
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//The cubes cover the whole search space, so if all of them have been
+//refuted (by whichever thread), the problem is UNSAT
+void Solver::set_unsat_all_cubes_refuted()
+{
+    assert(decisionLevel() == 0);
+    ok = false;
+    conflict.clear();
+}
+
 bool Solver::verify_model_implicit_clauses() const
 {
     uint32_t wsLit = 0;
@@ -2753,7 +3018,7 @@ void Solver::calculate_reachability()
 
         //Check if it's a good idea to look at the variable as a dominator
         if (value(lit) != l_Undef
-            || varData[lit.var()].removed != Removed::none
+            || varDataCold[lit.var()].removed != Removed::none
         ) {
             continue;
         }
@@ -2798,9 +3063,9 @@ void Solver::free_unused_watches()
         ; ++it, wsLit++
     ) {
         Lit lit = Lit::toLit(wsLit);
-        if (varData[lit.var()].removed == Removed::elimed
-            || varData[lit.var()].removed == Removed::replaced
-            || varData[lit.var()].removed == Removed::decomposed
+        if (varDataCold[lit.var()].removed == Removed::elimed
+            || varDataCold[lit.var()].removed == Removed::replaced
+            || varDataCold[lit.var()].removed == Removed::decomposed
         ) {
             watch_subarray ws = *it;
             assert(ws.empty());
@@ -2827,7 +3092,7 @@ bool Solver::fully_enqueue_this(const Lit lit)
 {
     const lbool val = value(lit);
     if (val == l_Undef) {
-        assert(varData[lit.var()].removed == Removed::none);
+        assert(varDataCold[lit.var()].removed == Removed::none);
         enqueue(lit);
         ok = propagate<true>().isNULL();
 
@@ -2869,14 +3134,14 @@ unsigned long Solver::get_sql_id() const
     return sqlStats->get_runID();
 }
 
-bool Solver::add_clause_outer(const vector<Lit>& lits)
+bool Solver::add_clause_outer(const vector<Lit>& lits, LoadedClauses* loaded)
 {
     if (!ok) {
         return false;
     }
     check_too_large_variable_number(lits);
     back_number_from_outside_to_outer(lits);
-    return addClause(back_number_from_outside_to_outer_tmp);
+    return addClause(back_number_from_outside_to_outer_tmp, loaded);
 }
 
 bool Solver::add_xor_clause_outer(const vector<Var>& vars, bool rhs)
@@ -2898,6 +3163,51 @@ bool Solver::add_xor_clause_outer(const vector<Var>& vars, bool rhs)
     return ok;
 }
 
+/**
+@brief Adds a clause learnt elsewhere, e.g. by another solver
+
+The clause must be implied by the problem. It is added as redundant, so it
+is subject to clause cleaning. Clauses over eliminated or decomposed
+variables are dropped: they are a hint only.
+
+The clause is written to DRUP as a lemma. The proof then only checks if the
+clause is RUP with respect to the clauses before it in the proof, which a
+clause learnt by another solver need not be.
+*/
+bool Solver::add_red_clause_outer(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (!ok) {
+        return false;
+    }
+    assert(decisionLevel() == 0);
+    check_too_large_variable_number(lits);
+    back_number_from_outside_to_outer(lits);
+
+    vector<Lit> ps;
+    for(Lit lit: back_number_from_outside_to_outer_tmp) {
+        lit = varReplacer->get_lit_replaced_with_outer(lit);
+        lit = map_outer_to_inter(lit);
+        if (lit.var() >= nVars()
+            || varDataCold[lit.var()].removed != Removed::none
+        ) {
+            return true;
+        }
+        ps.push_back(lit);
+    }
+
+    //Goes into DRUP as a lemma. A binary is also sent to the other threads,
+    //they drop it if they already have it
+    ClauseStats cl_stats;
+    cl_stats.glue = std::max<uint32_t>(glue, 1);
+    update_red_tier(cl_stats);
+    Clause* cl = add_clause_int(ps, true, cl_stats, true, NULL, true);
+    if (cl != NULL) {
+        longRedCls.push_back(cl_alloc.get_offset(cl));
+    }
+
+    return ok;
+}
+
 void Solver::check_too_large_variable_number(const vector<Lit>& lits) const
 {
     for (const Lit lit: lits) {
@@ -3050,18 +3360,18 @@ Var Solver::num_active_vars() const
     uint32_t removed_non_decision = 0;
     for(Var var = 0; var < solver->nVarsOuter(); var++) {
         if (value(var) != l_Undef) {
-            if (varData[var].removed != Removed::none)
+            if (varDataCold[var].removed != Removed::none)
             {
                 cout << "ERROR: var " << var + 1 << " has removed: "
-                << removed_type_to_string(varData[var].removed)
+                << removed_type_to_string(varDataCold[var].removed)
                 << " but is set to " << value(var) << endl;
-                assert(varData[var].removed == Removed::none);
+                assert(varDataCold[var].removed == Removed::none);
                 exit(-1);
             }
             removed_set++;
             continue;
         }
-        switch(varData[var].removed) {
+        switch(varDataCold[var].removed) {
             case Removed::decomposed :
                 removed_decomposed++;
                 continue;
@@ -3077,7 +3387,7 @@ Var Solver::num_active_vars() const
             case Removed::none:
                 break;
         }
-        if (varData[var].removed != Removed::none) {
+        if (varDataCold[var].removed != Removed::none) {
             removed_non_decision++;
         }
         numActive++;
@@ -3453,7 +3763,7 @@ void Solver::parse_v_line(StreamBuffer<A, B, C>* in, const size_t lineNum)
 
         //Don't overwrite previously computed values
         if (model[var] == l_Undef
-            && varData[var].removed == Removed::none
+            && varDataCold[var].removed == Removed::none
         ) {
             model[var] = parsed_lit < 0 ? l_False : l_True;
         }
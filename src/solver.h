@@ -25,6 +25,7 @@
 #include "constants.h"
 #include <vector>
 #include <fstream>
+#include <mutex>
 
 #include "constants.h"
 #include "solvertypes.h"
@@ -75,6 +76,32 @@ class LitReachData {
 };
 
 
+/**
+@brief Clauses the way a Solver stored them while loading a batch of clauses
+
+Solvers in the same state store the same clauses, so these can be cloned
+into the others instead of every one of them normalizing the batch again.
+*/
+struct LoadedClauses
+{
+    vector<Lit> units;
+    vector<Lit> bins; ///<Two lits each
+    vector<Lit> tris; ///<Three lits each
+    vector<ClOffset> longs; ///<In the loading Solver's allocator
+};
+
+/**
+@brief Hands learnt clauses, in outside numbering, to the library's user
+*/
+struct LearntCallback
+{
+    void (*func)(void* state, const vector<Lit>& lits, uint32_t glue) = NULL;
+    void* state = NULL;
+    uint32_t max_size = 0;
+    uint32_t max_glue = 0;
+    std::mutex* mu = NULL; ///<Serializes calls coming from different threads
+};
+
 class Solver : public Searcher
 {
     public:
@@ -85,11 +112,22 @@ class Solver : public Searcher
         const vector<std::pair<string, string> >& get_sql_tags() const;
         void new_external_var();
         void new_external_vars(size_t n);
-        bool add_clause_outer(const vector<Lit>& lits);
+        bool add_clause_outer(const vector<Lit>& lits, LoadedClauses* loaded = NULL);
+        bool add_clauses_outer(
+            const Lit* lits
+            , size_t num_lits
+            , LoadedClauses* loaded = NULL
+        );
+        bool clone_loaded_clauses(
+            const Solver& from
+            , const LoadedClauses& loaded
+            , const bool arena_shared = false
+        );
         bool add_xor_clause_outer(const vector<Var>& vars, bool rhs);
+        bool add_red_clause_outer(const vector<Lit>& lits, uint32_t glue);
 
         lbool solve_with_assumptions(const vector<Lit>* _assumptions = NULL);
-        void  set_shared_data(SharedData* shared_data);
+        void  set_shared_data(SharedData* shared_data, uint32_t thread_num);
         lbool model_value (const Lit p) const;  ///<Found model value for lit
         lbool model_value (const Var p) const;  ///<Found model value for var
         const vector<lbool>& get_model() const;
@@ -108,6 +146,8 @@ class Solver : public Searcher
         static const char* get_compilation_env();
 
         vector<Lit> get_zero_assigned_lits() const;
+        bool cube_refuted_at_zero(const vector<Lit>& cube) const;
+        void set_unsat_all_cubes_refuted();
         void     print_stats() const;
         void     print_clause_stats() const;
         size_t get_num_free_vars() const;
@@ -145,7 +185,9 @@ class Solver : public Searcher
         VarReplacer *varReplacer = NULL;
         SubsumeImplicit *subsumeImplicit = NULL;
         DataSync *datasync = NULL;
+        LearntCallback learnt_callback;
         ReduceDB* reduceDB = NULL;
+        Distiller* distiller = NULL;
         vector<LitReachData> litReachable;
 
         Stats sumStats;
@@ -165,7 +207,7 @@ class Solver : public Searcher
         lbool load_solution_from_file(const string& fname);
 
         uint64_t getNumLongClauses() const;
-        bool addClause(const vector<Lit>& ps);
+        bool addClause(const vector<Lit>& ps, LoadedClauses* loaded = NULL);
         bool add_xor_clause_inter(
             const vector< Lit >& lits
             , bool rhs
@@ -240,6 +282,9 @@ class Solver : public Searcher
         void reset_reason_levels_of_vars_to_zero();
 
         vector<Lit> finalCl_tmp;
+        vector<Lit> add_clauses_tmp;
+        void record_loaded_clause(const Clause* cl, LoadedClauses* loaded) const;
+        void check_no_blocked_clauses() const;
         bool sort_and_clean_clause(vector<Lit>& ps, const vector<Lit>& origCl);
         void set_up_sql_writer();
         vector<std::pair<string, string> > sql_tags;
@@ -295,7 +340,6 @@ class Solver : public Searcher
         Prober              *prober = NULL;
         InTree              *intree = NULL;
         OccSimplifier       *simplifier = NULL;
-        Distiller           *distiller = NULL;
         DistillerWithBin    *distillerwithbin = NULL;
         CompHandler         *compHandler = NULL;
 
@@ -49,7 +49,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxNumRedsRatio(10)
         , clauseDecayActivity(1.0/0.999)
         , min_time_in_db_before_eligible_for_cleaning(5ULL*1000ULL)
-        , glue_must_keep_clause_if_below_or_eq(5)
+        , glue_must_keep_clause_if_below_or_eq(2)
+        , glue_put_tier2_if_below_or_eq(6)
 
         //Restarting
         , restart_first(300)
@@ -62,6 +63,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , local_glue_multiplier(0.80)
         , shortTermHistorySize (50)
         , lower_bound_for_blocking_restart(10000)
+        , chrono_backtrack(-1)
         , more_otf_shrink_with_cache(false)
         , more_otf_shrink_with_stamp(false)
 
@@ -74,6 +76,8 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , more_red_minim_limit_cache(400)
         , more_red_minim_limit_binary(200)
         , max_num_lits_more_red_min(1)
+        , doMinimRedBinGraph(true)
+        , bin_graph_minim_max_steps(2000)
         , extra_bump_var_activities_based_on_glue(true)
 
         //Verbosity
@@ -88,6 +92,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         //Limits
         , maxTime          (std::numeric_limits<double>::max())
         , maxConfl         (std::numeric_limits<long>::max())
+        , terminate_poll_props(20000)
 
         //Glues
         , update_glues_on_prop(false)
@@ -167,6 +172,10 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Propagation & search
         , propBinFirst     (false)
+        , doBinBlockFirst  (true)
+        , doSIMDBinProp    (true)
+        , doPropPrefetch   (true)
+        , prop_prefetch_cls(4)
         , dominPickFreq    (0)
 
         //Iterative Alo Scheduling
@@ -211,10 +220,14 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , distill_long_irred_cls_time_limitM(10ULL)
         , watch_cache_stamp_based_str_time_limitM(30LL)
         , distill_time_limitM(120LL)
+        , do_distill_red_clauses(true)
+        , distill_red_cls_time_limitM(1ULL)
 
         //Memory savings
         , doRenumberVars   (true)
+        , renumber_by_occur(true)
         , doSaveMem        (true)
+        , huge_pages(false)
 
         //Component finding
         , doCompHandler    (true)
@@ -247,6 +260,17 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , maxDumpRedsSize(std::numeric_limits<uint32_t>::max())
         , origSeed(0)
         , sync_every_confl(20000)
+        , thread_pinning(0)
+        , deterministic_sync(false)
+        , sync_every_props(10ULL*1000ULL*1000ULL)
+        , do_cube_and_conquer(false)
+        , cube_depth(0)
+        , cube_lookahead_vars(40)
+        , share_ring_size_log2(14)
+        , share_long_max_glue(2)
+        , share_long_glue_adapt(true)
+        , share_long_glue_adapt_max(6)
+        , share_irred_arena(false)
         , clean_after_perc_zero_depth_assigns(0.015)
         , reconfigure_val(0)
         , reconfigure_at(2)
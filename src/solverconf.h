@@ -148,7 +148,8 @@ class SolverConf
         double    maxNumRedsRatio; ///<Number of red clauses must not be more than red*maxNumRedsRatio
         double    clauseDecayActivity;
         unsigned  min_time_in_db_before_eligible_for_cleaning;
-        unsigned glue_must_keep_clause_if_below_or_eq;
+        unsigned glue_must_keep_clause_if_below_or_eq; ///<Core tier, kept forever
+        unsigned glue_put_tier2_if_below_or_eq; ///<Tier2, kept while used between cleanings
 
         //For restarting
         unsigned    restart_first;      ///<The initial restart limit.                                                                (default 100)
@@ -161,6 +162,7 @@ class SolverConf
         double   local_glue_multiplier;
         unsigned  shortTermHistorySize; ///< Rolling avg. glue window size
         unsigned lower_bound_for_blocking_restart;
+        int      chrono_backtrack; ///<Backtrack one level instead of backjumping further than this. -1 = never
         int more_otf_shrink_with_cache;
         int more_otf_shrink_with_stamp;
 
@@ -173,6 +175,8 @@ class SolverConf
         unsigned more_red_minim_limit_cache;
         unsigned more_red_minim_limit_binary;
         unsigned max_num_lits_more_red_min;
+        int doMinimRedBinGraph; ///<Minimise every learnt clause along the binary implication graph
+        unsigned bin_graph_minim_max_steps; ///<Watches looked at per learnt clause by the above
         int extra_bump_var_activities_based_on_glue;
 
         //Verbosity
@@ -187,6 +191,7 @@ class SolverConf
         //Limits
         double   maxTime;
         long maxConfl;
+        uint64_t terminate_poll_props; ///<Propagations, or equivalent work, between calls of the terminate callback
 
         //Glues
         int       update_glues_on_prop;
@@ -266,6 +271,10 @@ class SolverConf
 
         //Propagation & searching
         int      propBinFirst;
+        int      doBinBlockFirst; ///<During search, keep binaries in a block at the front of each watchlist
+        int      doSIMDBinProp; ///<Use SIMD on the binaries at the front of the watchlists, if the CPU can
+        int      doPropPrefetch; ///<Prefetch the watchlists and clauses of the literals coming up on the trail
+        unsigned prop_prefetch_cls; ///<Number of long clauses to prefetch per upcoming watchlist
         unsigned  dominPickFreq;
 
         //Iterative Alo Scheduling
@@ -294,10 +303,14 @@ class SolverConf
         unsigned long long distill_long_irred_cls_time_limitM;
         long watch_cache_stamp_based_str_time_limitM;
         long long distill_time_limitM;
+        int      do_distill_red_clauses; ///<Vivify the core and tier2 red clauses after every cleaning
+        unsigned long long distill_red_cls_time_limitM;
 
         //Memory savings
         int       doRenumberVars;
+        int       renumber_by_occur; ///<Renumber variables in the order they occur in the irred clauses
         int       doSaveMem;
+        int       huge_pages; ///<Ask for transparent huge pages for the clause slabs and pooled watchlists
 
         //Component handling
         int       doCompHandler;
@@ -334,6 +347,17 @@ class SolverConf
         unsigned  maxDumpRedsSize; ///<When dumping the redundant clauses, this is the maximum clause size that should be dumped
         unsigned origSeed;
         unsigned long long sync_every_confl;
+        int      thread_pinning; ///<Pin threads to CPUs. 0 = no, 1 = fill NUMA nodes one by one, 2 = spread over NUMA nodes
+        int      deterministic_sync; ///<Threads only sync at fixed points, runs are reproducible
+        unsigned long long sync_every_props; ///<Length of a round in deterministic mode
+        int      do_cube_and_conquer; ///<Split into cubes by lookahead, threads solve them under assumptions
+        unsigned cube_depth; ///<Depth of the cube tree, 0 means decide based on the number of threads
+        unsigned cube_lookahead_vars; ///<Number of variables to look ahead on when picking a split variable
+        unsigned share_ring_size_log2; ///<Each thread can have 2^N clauses in flight to the others
+        unsigned share_long_max_glue; ///<Share learnt clauses of 3+ literals with at most this glue
+        int      share_long_glue_adapt; ///<Tune the glue limit above by how useful imported clauses were
+        unsigned share_long_glue_adapt_max;
+        int      share_irred_arena; ///<Threads share one copy-on-write copy of the irredundant long clauses. Off by default: propagation soon copies most pages
         double clean_after_perc_zero_depth_assigns;
         unsigned reconfigure_val;
         unsigned reconfigure_at;
@@ -30,22 +30,37 @@ namespace CMSat
 {
 using namespace CMSat;
 
+/**
+@brief What propagation and conflict analysis need of a variable
+
+Written by every enqueue and read for every literal of every reason during
+analysis. Kept to 16 bytes, so an entry never straddles a cache line. The
+rest of the data of the variable is in VarDataCold.
+*/
 struct VarData
 {
     ///contains the decision level at which the assignment was made.
     uint32_t level = 0;
 
-    //Used during hyper-bin and trans-reduction for speed
-    uint32_t depth = 0;
-
     //Reason this got propagated. NULL means decision/toplevel
     PropBy reason = PropBy();
 
+    ///The preferred polarity of each variable.
+    bool polarity = false;
+};
+static_assert(sizeof(VarData) == 16, "VarData must stay 16 bytes");
+
+/**
+@brief Data of a variable that the search itself does not touch
+*/
+struct VarDataCold
+{
+    //Used during hyper-bin and trans-reduction for speed
+    uint32_t depth = 0;
+
     ///Whether var has been eliminated (var-elim, different component, etc.)
     Removed removed = Removed::none;
 
-    ///The preferred polarity of each variable.
-    bool polarity = false;
     bool is_bva = false;
 };
 
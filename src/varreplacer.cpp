@@ -69,12 +69,12 @@ void VarReplacer::check_no_replaced_var_set() const
 {
     for(Var var = 0; var < solver->nVarsOuter(); var++) {
         if (solver->value(var) != l_Undef) {
-            if (solver->varData[var].removed != Removed::none)
+            if (solver->varDataCold[var].removed != Removed::none)
             {
                 cout << "ERROR: var " << var + 1 << " has removed: "
-                << removed_type_to_string(solver->varData[var].removed)
+                << removed_type_to_string(solver->varDataCold[var].removed)
                 << " but is set to " << solver->value(var) << endl;
-                assert(solver->varData[var].removed == Removed::none);
+                assert(solver->varDataCold[var].removed == Removed::none);
                 exit(-1);
             }
         }
@@ -131,21 +131,21 @@ void VarReplacer::update_vardata_and_activities(
 ) {
     //Not replaced_with, or not replaceable, so skip
     if (orig == replaced_with
-        || solver->varData[replaced_with].removed == Removed::decomposed
-        || solver->varData[replaced_with].removed == Removed::elimed
+        || solver->varDataCold[replaced_with].removed == Removed::decomposed
+        || solver->varDataCold[replaced_with].removed == Removed::elimed
     ) {
         return;
     }
 
     //Has already been handled previously, just skip
-    if (solver->varData[orig].removed == Removed::replaced) {
+    if (solver->varDataCold[orig].removed == Removed::replaced) {
         return;
     }
 
     //Okay, so unset decision, and set the other one decision
     assert(orig != replaced_with);
-    solver->varData[orig].removed = Removed::replaced;
-    assert(solver->varData[replaced_with].removed == Removed::none);
+    solver->varDataCold[orig].removed = Removed::replaced;
+    assert(solver->varDataCold[replaced_with].removed == Removed::none);
     assert(solver->value(replaced_with) == l_Undef);
 
     solver->set_decision_var(replaced_with);
@@ -661,7 +661,7 @@ bool VarReplacer::handleUpdatedClause(
     uint32_t i, j;
     const uint32_t origSize = c.size();
     for (i = j = 0, p = lit_Undef; i != origSize; i++) {
-        assert(solver->varData[c[i].var()].removed == Removed::none);
+        assert(solver->varDataCold[c[i].var()].removed == Removed::none);
         if (solver->value(c[i]) == l_True || c[i] == ~p) {
             satisfied = true;
             break;
@@ -761,7 +761,7 @@ void VarReplacer::set_sub_var_during_solution_extension(Var var, const Var sub_v
 {
     const lbool to_set = solver->model[var] ^ table[sub_var].sign();
     const Var sub_var_inter = solver->map_outer_to_inter(sub_var);
-    assert(solver->varData[sub_var_inter].removed == Removed::replaced);
+    assert(solver->varDataCold[sub_var_inter].removed == Removed::replaced);
     assert(solver->model[sub_var] == l_Undef);
 
     if (solver->conf.verbosity >= 20) {
@@ -816,8 +816,8 @@ void VarReplacer::replaceChecks(const Var var1, const Var var2) const
     assert(solver->value(var1) == l_Undef);
     assert(solver->value(var2) == l_Undef);
 
-    assert(solver->varData[var1].removed == Removed::none);
-    assert(solver->varData[var2].removed == Removed::none);
+    assert(solver->varDataCold[var1].removed == Removed::none);
+    assert(solver->varDataCold[var2].removed == Removed::none);
 }
 
 bool VarReplacer::handleAlreadyReplaced(const Lit lit1, const Lit lit2)
@@ -919,8 +919,8 @@ bool VarReplacer::replace(
     << lit1 << ~lit2 << fin;
 
     //None should be removed, only maybe queued for replacement
-    assert(solver->varData[lit1.var()].removed == Removed::none);
-    assert(solver->varData[lit2.var()].removed == Removed::none);
+    assert(solver->varDataCold[lit1.var()].removed == Removed::none);
+    assert(solver->varDataCold[lit2.var()].removed == Removed::none);
 
     const lbool val1 = solver->value(lit1);
     const lbool val2 = solver->value(lit2);
@@ -992,8 +992,8 @@ void VarReplacer::checkUnsetSanity()
         const Lit repLit = get_lit_replaced_with(Lit(i, false));
         const Var repVar = get_var_replaced_with(i);
 
-        if (solver->varData[i].removed == Removed::none
-            && solver->varData[repVar].removed == Removed::none
+        if (solver->varDataCold[i].removed == Removed::none
+            && solver->varDataCold[repVar].removed == Removed::none
             && solver->value(i) != solver->value(repLit)
         ) {
             cout
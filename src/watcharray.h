@@ -24,8 +24,13 @@ THE SOFTWARE.
 #ifndef __WATCHARRAY_H__
 #define __WATCHARRAY_H__
 
+#ifdef WATCH_POOLED
+#include "watcharray_handrolled.h"
+#else
+
 #include "watched.h"
 #include "Vec.h"
+#include "hugepages.h"
 #include <vector>
 
 namespace CMSat {
@@ -219,6 +224,16 @@ public:
         return watches.size();
     }
 
+    //Every literal's watchlist is a separate malloc-ed vector, so they can
+    //neither be put on huge pages nor counted apart from the rest of the heap
+    void set_huge_pages(const bool)
+    {
+    }
+
+    void count_pages(HugePages::PageStats&) const
+    {
+    }
+
     void prefetch(const size_t at) const
     {
         __builtin_prefetch(watches[at].data());
@@ -364,4 +379,6 @@ inline void swap(watch_subarray a, watch_subarray b)
 
 } //End of namespace
 
+#endif //WATCH_POOLED
+
 #endif //__WATCHARRAY_H__
@@ -19,67 +19,150 @@
  * MA 02110-1301  USA
 */
 
+#ifdef WATCH_POOLED
 #include "watcharray.h"
+#include "solvertypes.h"
 #include <algorithm>
+#include <iomanip>
 using namespace CMSat;
 
+/**
+@brief The pool with at least 'elems' free at its end
+
+Only the last pool is allocated from. If the list does not fit there, the
+rest of it goes onto the free lists and a new, larger pool is made. A list
+larger than WATCH_MAX_SIZE_ONE_ALLOC fills a new pool of its own.
+*/
+uint32_t watch_array::get_suitable_base(uint32_t elems)
+{
+    assert(!mems.empty());
+    const uint32_t last = mems.size()-1;
+    if ((uint64_t)mems[last].next_space_offset + elems <= mems[last].alloc) {
+        return last;
+    }
+
+    put_free_space(last, mems[last].next_space_offset, mems[last].alloc);
+    mems[last].next_space_offset = mems[last].alloc;
+    if (mems.size() >= WATCH_MAX_MEMS) {
+        std::cerr
+        << "ERROR: watchlist pools can't handle the load"
+        << " pools: " << mems.size()
+        << endl;
+
+        throw std::bad_alloc();
+    }
+
+    Mem new_mem;
+    const uint64_t grown = std::min<uint64_t>(2ULL*mems[last].alloc, WATCH_MAX_SIZE_ONE_ALLOC);
+    new_mem.alloc = std::max<uint64_t>(grown, elems);
+    map_mem(new_mem);
+    mems.push_back(new_mem);
+    return mems.size()-1;
+}
+
+/**
+@brief Puts [from, to) of a pool onto the free lists, in blocks of the largest classes that fit
+*/
+void watch_array::put_free_space(uint32_t num, uint32_t from, uint32_t to)
+{
+    while(to - from >= 2) {
+        const uint32_t left = to - from;
+        const uint32_t k = (sizeof(unsigned)*8 - 1) - __builtin_clz(left);
+        uint32_t bucket = (3U << (k-1)) <= left ? 2*k-1 : 2*k-2;
+        bucket = std::min<uint32_t>(bucket, free_mem.size()-1);
+        free_mem[bucket].push_back(mems[num].base_ptr + from);
+        from += bucket_size(bucket);
+    }
+}
+
+Watched* watch_array::get_space(uint32_t elems)
+{
+    vector<Watched*>& fr = free_mem[get_bucket(elems)];
+    if (!fr.empty()) {
+        Watched* toret = fr.back();
+        fr.pop_back();
+        free_mem_used++;
+        return toret;
+    }
+    free_mem_not_used++;
+
+    const uint32_t num = get_suitable_base(elems);
+    Mem& mem = mems[num];
+    const uint32_t off_to_ret = mem.next_space_offset;
+    mem.next_space_offset += elems;
+    assert(mem.next_space_offset <= mem.alloc);
+
+    return mem.base_ptr + off_to_ret;
+}
+
+/**
+@brief Compacts the pools in place
+
+The lists are visited in address order and moved to the lowest place they fit
+in, with their capacity cut to the smallest size class that holds them. A list
+never gets bigger, so it only ever moves backwards, over memory that has
+already been vacated. The pools that end up empty are given back, and so are
+the pages at the end of the last one.
+*/
 void watch_array::consolidate()
 {
-    size_t total_needed = total_needed_during_consolidate();
-
-    vector<Mem> newmems;
-    size_t at_watches = 0;
-    //size_t last_needed = 0;
-    while(total_needed > 0) {
-        Mem newmem;
-        size_t needed = std::min<size_t>(total_needed, WATCH_MAX_SIZE_ONE_ALLOC);
-        assert(needed > 0);
-
-        //If last one was larger than this, let's take the last one
-        //needed = std::max<size_t>(needed, last_needed/2);
-        //last_needed = needed;
-        total_needed -= needed;
-
-        newmem.alloc = needed;
-        newmem.base_ptr = (Watched*)malloc(newmem.alloc*sizeof(Watched));
-        for(; at_watches < watches.size(); at_watches++) {
-            //Not used
-            if (watches[at_watches].size == 0) {
-                watches[at_watches] = Elem();
-                continue;
-            }
-
-            Elem& ws = watches[at_watches];
-
-            //Allow for some space to breathe
-            size_t toalloc = extra_space_during_consolidate(ws.size);
-
-            //Does not fit into this 'newmem'
-            if (newmem.next_space_offset + toalloc > newmem.alloc) {
-                break;
-            }
-
-            ws.alloc = toalloc;
-            Watched* orig_ptr = mems[ws.num].base_ptr + ws.offset;
-            Watched* new_ptr = newmem.base_ptr + newmem.next_space_offset;
-            memmove(new_ptr, orig_ptr, ws.size * sizeof(Watched));
-            ws.num = newmems.size();
-            ws.offset = newmem.next_space_offset;
-            //ws.accessed = 0;
-            newmem.next_space_offset += ws.alloc;
+    //Pool of the list, and the list
+    vector<std::pair<uint32_t, uint32_t> > order;
+    for(size_t i = 0; i < watches.size(); i++) {
+        if (watches[i].size == 0) {
+            watches[i] = Elem();
+        } else {
+            order.push_back(std::make_pair(find_mem(watches[i].ptr), i));
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](
+        const std::pair<uint32_t, uint32_t>& a
+        , const std::pair<uint32_t, uint32_t>& b
+    ) {
+        if (a.first != b.first) {
+            return a.first < b.first;
         }
-        newmems.push_back(newmem);
+        return watches[a.second].ptr < watches[b.second].ptr;
+    });
+
+    uint32_t at_mem = 0;
+    uint32_t at_offs = 0;
+    for(const auto& p: order) {
+        Elem& ws = watches[p.second];
+        const uint32_t alloc = alloc_for_size(ws.size);
+        assert(alloc <= ws.alloc);
+        while(at_offs + alloc > mems[at_mem].alloc) {
+            mems[at_mem].next_space_offset = at_offs;
+            at_mem++;
+            at_offs = 0;
+        }
+
+        Watched* new_ptr = mems[at_mem].base_ptr + at_offs;
+        assert(at_mem < p.first || (at_mem == p.first && new_ptr <= ws.ptr));
+        if (ws.ptr != new_ptr) {
+            memmove(new_ptr, ws.ptr, ws.size * sizeof(Watched));
+        }
+        ws.ptr = new_ptr;
+        ws.alloc = alloc;
+        at_offs += alloc;
     }
-    assert(at_watches == watches.size());
-    assert(total_needed == 0);
+    mems[at_mem].next_space_offset = at_offs;
 
-    for(size_t i = 0; i < mems.size(); i++) {
-        free(mems[i].base_ptr);
+    while(mems.size() > at_mem+1) {
+        unmap_mem(mems.back());
+        mems.pop_back();
+    }
+    if (mems.back().mapped) {
+        const Mem& mem = mems.back();
+        HugePages::release(mem.base_ptr + mem.next_space_offset
+            , (size_t)(mem.alloc - mem.next_space_offset)*sizeof(Watched));
     }
 
-    mems = newmems;
-    for(auto& mem: free_mem) {
-        mem.clear();
+    for(auto& fr: free_mem) {
+        fr.clear();
+    }
+    for(uint32_t i = 0; i+1 < mems.size(); i++) {
+        put_free_space(i, mems[i].next_space_offset, mems[i].alloc);
     }
     free_mem_used = 0;
     free_mem_not_used = 0;
@@ -101,21 +184,19 @@ void watch_array::print_stat(bool detailed) const
         for(size_t i = 0; i < mems.size(); i++) {
             const Mem& mem = mems[i];
             cout
-            << " c [watch] mem " << i
+            << "c [watch] mem " << i
             << " alloc: " << mem.alloc
             << " next_space_offset: " << mem.next_space_offset
             << " base_ptr: " << mem.base_ptr
             << endl;
         }
 
-            cout << "c [watch] free stats:" << endl;
-            for(size_t i = 0; i < free_mem.size(); i++)
-            {
-                cout << "c [watch] ->free_mem[" << i << "]: " << free_mem[i].size() << endl;
-            }
+        cout << "c [watch] free stats:" << endl;
+        for(size_t i = 0; i < free_mem.size(); i++)
+        {
+            cout << "c [watch] ->free_mem[" << i << "]: " << free_mem[i].size() << endl;
         }
+    }
+}
 
-    /*for(size_t i = 0; i < watches.size(); i++) {
-        cout << "ws[" << i << "] accessed: " << watches[i].accessed << " size: " << watches[i].size << endl;
-    }*/
-}
\ No newline at end of file
+#endif //WATCH_POOLED
@@ -19,11 +19,13 @@
  * MA 02110-1301  USA
 */
 
-#ifndef __WATCHARRAY_H__
-#define __WATCHARRAY_H__
+#ifndef __WATCHARRAY_HANDROLLED_H__
+#define __WATCHARRAY_HANDROLLED_H__
 
 #include <stdlib.h>
+#include <string.h>
 #include "watched.h"
+#include "hugepages.h"
 #include <vector>
 
 namespace CMSat {
@@ -32,25 +34,24 @@ using std::vector;
 
 struct watch_array;
 
+/**
+@brief Where the watchlist of a literal is in the pools
+
+The capacity 'alloc' is always 0 or one of the size classes 2, 3, 4, 6, 8, 12, ...
+The pools never move, so the list is reached with one load, like a vec. The
+pool the list is in is only looked up when the list is moved.
+*/
 struct Elem
 {
-    Elem() :
-        num(0)
-        , offset(0)
-    {}
-
-    uint32_t num:8;
-    uint32_t offset:24;
+    Watched* ptr = NULL; ///<Start of the list, NULL if nothing is allocated
     uint32_t size = 0;
     uint32_t alloc = 0;
-    //uint32_t accessed = 0;
 
     void print_stat() const
     {
         cout
         << "c elem."
-        << " num: " << num
-        << " offset:" << offset
+        << " ptr: " << ptr
         << " size" << size
         << " alloc" << alloc
         << endl;
@@ -62,22 +63,7 @@ struct Mem
     uint32_t alloc = 0;
     Watched* base_ptr = NULL;
     uint32_t next_space_offset = 0;
-};
-
-struct OffsAndNum
-{
-    OffsAndNum() :
-        offset(0)
-        , num(0)
-    {}
-
-    OffsAndNum(uint32_t _offset, uint32_t _num) :
-        offset(_offset)
-        , num(_num)
-    {}
-
-    uint32_t offset;
-    uint32_t num;
+    bool mapped = false; ///<base_ptr is from HugePages::map(), not malloc()
 };
 
 struct watch_subarray
@@ -90,6 +76,7 @@ struct watch_subarray
     {}
 
     Watched& operator[](const uint32_t at);
+    Watched& at(const uint32_t at);
     void clear();
     uint32_t size() const;
     bool empty() const;
@@ -122,6 +109,7 @@ struct watch_subarray_const
 
     void print_stat() const;
     const Watched& operator[](const uint32_t at) const;
+    const Watched& at(const uint32_t at) const;
     uint32_t size() const;
     bool empty() const;
     const Watched* begin() const;
@@ -129,149 +117,193 @@ struct watch_subarray_const
     typedef const Watched* const_iterator;
 };
 
+/**
+@brief Watchlists of all literals, in a few large pools
+
+Every list has the capacity of a size class, the classes grow by 1.5x like
+vec does. When a list is full, it moves to a block of the next class and its
+old block goes onto the free list of its own class.
+New blocks are taken from the free lists first, then from the end of the last
+pool. This replaces the millions of small reallocs of one vec per literal,
+and the pools can be put on huge pages.
+
+consolidate() compacts the pools in place: the lists are moved towards the
+start of the pools in address order, with their capacity cut to fit, and the
+pools left empty are given back.
+
+A list larger than WATCH_MAX_SIZE_ONE_ALLOC gets a pool of its own. Lists
+can't grow beyond WATCH_MAX_LIST_ALLOC, the largest size class in 32 bits.
+*/
 struct watch_array
 {
-    const static size_t WATCH_MIN_SIZE_ONE_ALLOC_FIRST = 1ULL*1000ULL*1000ULL;
-    const static size_t WATCH_MIN_SIZE_ONE_ALLOC_LATER = 50ULL*1000ULL*1000ULL;
-    const static size_t WATCH_MAX_SIZE_ONE_ALLOC = (1ULL<<24)-1;
+    const static uint32_t WATCH_MIN_SIZE_ONE_ALLOC_FIRST = 1U<<20;
+    const static uint32_t WATCH_MAX_SIZE_ONE_ALLOC = 1U<<24;
+    const static uint32_t WATCH_MAX_LIST_ALLOC = 3U<<30;
+    const static size_t WATCH_MAX_MEMS = 256;
 
     vector<Elem> watches;
     vector<Mem> mems;
     size_t free_mem_used = 0;
     size_t free_mem_not_used = 0;
+    bool huge_pages = false;
 
-    //at least 2**N elements in there
-    vector<vector<OffsAndNum> > free_mem;
+    //Free blocks of bucket_size(N) elements
+    vector<vector<Watched*> > free_mem;
+
+    vector<Lit> smudged_list;
+    vector<char> smudged;
 
     watch_array()
     {
-        //We need at least 1
+        //New lists are carved from the end of the last pool
         Mem new_mem;
-        size_t elems = WATCH_MIN_SIZE_ONE_ALLOC_FIRST;
-        new_mem.base_ptr = (Watched*)malloc(elems*sizeof(Watched));
-        new_mem.alloc = elems;
+        new_mem.alloc = WATCH_MIN_SIZE_ONE_ALLOC_FIRST;
+        map_mem(new_mem);
         mems.push_back(new_mem);
 
-        free_mem.resize(20);
+        free_mem.resize(get_bucket(WATCH_MAX_LIST_ALLOC)+1);
     }
 
     ~watch_array()
     {
         for(size_t i = 0; i < mems.size(); i++) {
-            free(mems[i].base_ptr);
+            unmap_mem(mems[i]);
         }
     }
 
-    uint32_t get_suitable_base(uint32_t elems)
-    {
-        //print_stat();
+    //The pools are owned, and the subarrays point back here
+    watch_array(const watch_array&) = delete;
+    watch_array& operator=(const watch_array&) = delete;
 
-        assert(mems.size() > 0);
-        size_t last_alloc = mems[0].alloc;
-        for(size_t i = 0; i < mems.size(); i++) {
-            if (mems[i].next_space_offset + elems < mems[i].alloc) {
-                return i;
-            }
-            last_alloc = mems[i].alloc;
+    void smudge(const Lit lit) {
+        if (!smudged[lit.toInt()]) {
+            smudged_list.push_back(lit);
+            smudged[lit.toInt()] = true;
         }
-        assert(mems.size() < 255);
+    }
 
-        Mem new_mem;
-        new_mem.alloc = std::max<size_t>(3*last_alloc, WATCH_MIN_SIZE_ONE_ALLOC_LATER);
-        new_mem.alloc = std::min<size_t>(3*last_alloc, WATCH_MAX_SIZE_ONE_ALLOC);
-        new_mem.base_ptr = (Watched*)malloc(new_mem.alloc*sizeof(Watched));
-        assert(new_mem.base_ptr != NULL);
-        mems.push_back(new_mem);
-        return mems.size()-1;
+    const vector<Lit>& get_smudged_list() const {
+        return smudged_list;
     }
 
-    bool find_free_space(OffsAndNum& toret, uint32_t size)
+    void clear_smudged()
     {
-        size_t bucket = get_bucket(size);
-        if (free_mem.size() <= bucket
-            || free_mem[bucket].empty()
-        ) {
-            free_mem_not_used++;
-            return false;
+        for(const Lit lit: smudged_list) {
+            assert(smudged[lit.toInt()]);
+            smudged[lit.toInt()] = false;
         }
-
-        toret = free_mem[bucket].back();
-        free_mem[bucket].pop_back();
-        free_mem_used++;
-        return true;
+        smudged_list.clear();
     }
 
-    OffsAndNum get_space(uint32_t elems)
+    //The pools are mapped aligned to huge pages, malloc is only a fallback
+    void map_mem(Mem& mem) const
     {
-        OffsAndNum toret;
-        if (find_free_space(toret, elems))
-            return toret;
-
-        uint32_t num = get_suitable_base(elems);
-        Mem& mem = mems[num];
-        assert(mem.next_space_offset + elems < mem.alloc);
-
-        uint32_t off_to_ret = mem.next_space_offset;
-        mem.next_space_offset += elems;
-
-        toret = OffsAndNum(off_to_ret, num);
-        return toret;
+        const size_t bytes = (size_t)mem.alloc*sizeof(Watched);
+        mem.base_ptr = (Watched*)HugePages::map(bytes, huge_pages, false);
+        mem.mapped = (mem.base_ptr != NULL);
+        if (!mem.mapped) {
+            mem.base_ptr = (Watched*)malloc(bytes);
+        }
+        if (mem.base_ptr == NULL) {
+            throw std::bad_alloc();
+        }
     }
 
-    size_t extra_space_during_consolidate(size_t orig_size)
+    void unmap_mem(Mem& mem) const
     {
-        if (orig_size == 1)
-            return 2;
-
-        unsigned bucket = get_bucket(orig_size);
-        if (2U<<bucket == orig_size)
-            return orig_size;
-        else
-            return 2U<<(bucket+1);
+        if (mem.mapped) {
+            HugePages::unmap(mem.base_ptr, (size_t)mem.alloc*sizeof(Watched));
+        } else {
+            free(mem.base_ptr);
+        }
+        mem.base_ptr = NULL;
     }
 
-    size_t total_needed_during_consolidate()
+    void set_huge_pages(const bool huge)
     {
-        size_t total_needed = 0;
-        for(size_t i = 0; i < watches.size(); i++) {
-            if (watches[i].size != 0) {
-                total_needed += extra_space_during_consolidate(watches[i].size);
+        huge_pages = huge;
+        if (!huge) {
+            return;
+        }
+        for(const Mem& mem: mems) {
+            if (mem.mapped) {
+                HugePages::advise(mem.base_ptr, (size_t)mem.alloc*sizeof(Watched));
             }
         }
-        total_needed *= 1.2;
-        total_needed = std::max<size_t>(total_needed, WATCH_MIN_SIZE_ONE_ALLOC_FIRST);
+    }
 
-        return total_needed;
+    void count_pages(HugePages::PageStats& stats) const
+    {
+        for(const Mem& mem: mems) {
+            if (mem.mapped) {
+                HugePages::count_pages(mem.base_ptr, (size_t)mem.alloc*sizeof(Watched), stats);
+            }
+        }
     }
 
-    void consolidate();
-    void print_stat(bool detailed = false) const;
+    //Size classes 2, 3, 4, 6, 8, 12, ...: 2**(N/2+1) for even N, 3*2**(N/2) for odd N
+    static uint32_t bucket_size(const uint32_t bucket)
+    {
+        if (bucket % 2 == 0) {
+            return 2U << (bucket/2);
+        }
+        return 3U << (bucket/2);
+    }
 
-    unsigned get_bucket(unsigned size)
+    //Smallest size class that holds 'size' elements, for size >= 2
+    static uint32_t get_bucket(const uint32_t size)
     {
-        //assert(size >= 2);
-        int at = ((int)((sizeof(unsigned)*8))-__builtin_clz(size))-2;
-        //assert(at >= 0);
-        return at;
+        assert(size >= 2);
+        if (size == 2) {
+            return 0;
+        }
+
+        //2**k < size <= 2**(k+1), the odd class 3*2**(k-1) splits the range
+        const uint32_t k = (sizeof(unsigned)*8 - 1) - __builtin_clz(size - 1);
+        if (size <= (3U << (k-1))) {
+            return 2*k-1;
+        }
+        return 2*k;
     }
 
-    void delete_offset(uint32_t num, uint32_t offs, uint32_t size)
+    //Capacity of a list of this size after consolidation
+    static uint32_t alloc_for_size(const uint32_t size)
     {
-        size_t bucket = get_bucket(size);
-        //assert(size == 2U<<bucket);
+        if (size == 0) {
+            return 0;
+        }
+        return bucket_size(get_bucket(std::max<uint32_t>(size, 2)));
+    }
 
-        if (bucket >= free_mem.size()) {
-            return;
+    //The pool that 'ptr' points into
+    uint32_t find_mem(const Watched* ptr) const
+    {
+        for(uint32_t i = 0; i < mems.size(); i++) {
+            if (ptr >= mems[i].base_ptr && ptr < mems[i].base_ptr + mems[i].alloc) {
+                return i;
+            }
         }
+        assert(false);
+        return 0;
+    }
+
+    uint32_t get_suitable_base(uint32_t elems);
+    void put_free_space(uint32_t num, uint32_t from, uint32_t to);
+    Watched* get_space(uint32_t elems);
 
-        free_mem[bucket].push_back(OffsAndNum(offs, num));
+    void delete_space(Watched* ptr, uint32_t alloc)
+    {
+        free_mem[get_bucket(alloc)].push_back(ptr);
     }
 
+    void consolidate();
+    void print_stat(bool detailed = false) const;
+
     size_t mem_used_alloc() const
     {
         size_t total = 0;
         for(size_t i = 0; i < mems.size(); i++) {
-            total += mems[i].alloc*sizeof(Watched);
+            total += (size_t)mems[i].alloc*sizeof(Watched);
         }
         return total;
     }
@@ -281,39 +313,65 @@ struct watch_array
         size_t total = 0;
         total += watches.capacity() * sizeof(Elem);
         total += mems.capacity() * sizeof(Mem);
+        for(const auto& fr: free_mem) {
+            total += fr.capacity() * sizeof(Watched*);
+        }
+        total += sizeof(watch_array);
         return total;
     }
 
+    size_t mem_used() const
+    {
+        size_t mem = mem_used_alloc() + mem_used_array();
+        mem += smudged.capacity()*sizeof(char);
+        mem += smudged_list.capacity()*sizeof(Lit);
+        return mem;
+    }
+
     watch_subarray operator[](size_t at)
     {
         assert(watches.size() > at);
         return watch_subarray(watches.begin() + at, this);
     }
 
+    watch_subarray at(size_t pos)
+    {
+        assert(watches.size() > pos);
+        return watch_subarray(watches.begin() + pos, this);
+    }
+
     watch_subarray_const operator[](size_t at) const
     {
         assert(watches.size() > at);
         return watch_subarray_const(watches.begin() + at, this);
     }
 
-    void resize(const size_t new_size)
+    watch_subarray_const at(size_t pos) const
     {
-        watches.resize(new_size);
+        assert(watches.size() > pos);
+        return watch_subarray_const(watches.begin() + pos, this);
     }
 
-    uint32_t size() const
+    void resize(const size_t new_size)
     {
-        return watches.size();
+        assert(smudged_list.empty());
+        for(size_t i = new_size; i < watches.size(); i++) {
+            if (watches[i].alloc > 0) {
+                delete_space(watches[i].ptr, watches[i].alloc);
+            }
+        }
+        watches.resize(new_size);
+        smudged.resize(new_size, false);
     }
 
-    void shrink_to_fit()
+    size_t size() const
     {
-        watches.shrink_to_fit();
+        return watches.size();
     }
 
     void prefetch(const size_t at) const
     {
-        __builtin_prefetch(mems[watches[at].num].base_ptr + watches[at].offset);
+        __builtin_prefetch(watches[at].ptr);
     }
 
     struct iterator
@@ -406,11 +464,6 @@ struct watch_array
     {
         return const_iterator(watches.end(), this);
     }
-
-    void fitToSize()
-    {
-        //TODO shirnk
-    }
 };
 
 inline size_t operator-(const watch_array::iterator& lhs, const watch_array::iterator& rhs)
@@ -425,7 +478,12 @@ inline size_t operator-(const watch_array::const_iterator& lhs, const watch_arra
 
 inline Watched& watch_subarray::operator[](const uint32_t at)
 {
-    //base_at->accessed++;
+    return *(begin() + at);
+}
+
+inline Watched& watch_subarray::at(const uint32_t at)
+{
+    assert(at < size());
     return *(begin() + at);
 }
 
@@ -446,7 +504,7 @@ inline bool watch_subarray::empty() const
 
 inline Watched* watch_subarray::begin()
 {
-    return base->mems[base_at->num].base_ptr + base_at->offset;
+    return base_at->ptr;
 }
 
 inline Watched* watch_subarray::end()
@@ -456,7 +514,7 @@ inline Watched* watch_subarray::end()
 
 inline const Watched* watch_subarray::begin() const
 {
-    return base->mems[base_at->num].base_ptr + base_at->offset;
+    return base_at->ptr;
 }
 
 inline const Watched* watch_subarray::end() const
@@ -466,6 +524,7 @@ inline const Watched* watch_subarray::end() const
 
 inline void watch_subarray::shrink(const uint32_t num)
 {
+    assert(num <= base_at->size);
     base_at->size -= num;
 }
 
@@ -476,20 +535,30 @@ inline void watch_subarray::shrink_(const uint32_t num)
 
 inline void watch_subarray::get_space_for_push()
 {
-    uint32_t new_alloc = std::max<uint32_t>(base_at->alloc*2, 2U);
-    OffsAndNum off_and_num = base->get_space(new_alloc);
+    uint32_t new_alloc = 2;
+    if (base_at->alloc >= watch_array::WATCH_MAX_LIST_ALLOC) {
+        std::cerr
+        << "ERROR: watchlist can't grow beyond "
+        << watch_array::WATCH_MAX_LIST_ALLOC << " elements"
+        << endl;
+
+        throw std::bad_alloc();
+    }
+    if (base_at->alloc > 0) {
+        new_alloc = watch_array::bucket_size(watch_array::get_bucket(base_at->alloc)+1);
+    }
+    Watched* newptr = base->get_space(new_alloc);
 
     //Copy
     if (base_at->size > 0) {
-        Watched* newptr = base->mems[off_and_num.num].base_ptr + off_and_num.offset;
-        Watched* oldptr = begin();
-        memmove(newptr, oldptr, size() * sizeof(Watched));
-        base->delete_offset(base_at->num, base_at->offset, base_at->alloc);
+        memcpy(newptr, begin(), size() * sizeof(Watched));
+    }
+    if (base_at->alloc > 0) {
+        base->delete_space(base_at->ptr, base_at->alloc);
     }
 
     //Update
-    base_at->num = off_and_num.num;
-    base_at->offset = off_and_num.offset;
+    base_at->ptr = newptr;
     base_at->alloc = new_alloc;
 }
 
@@ -500,9 +569,6 @@ inline void watch_subarray::push(const Watched& watched)
         get_space_for_push();
     }
 
-    //There is enough space
-    //assert(base_at->alloc > base_at->size);
-
     //Append to the end
     operator[](size()) = watched;
     base_at->size++;
@@ -512,6 +578,13 @@ inline const Watched& watch_subarray_const::operator[](const uint32_t at) const
 {
     return *(begin() + at);
 }
+
+inline const Watched& watch_subarray_const::at(const uint32_t at) const
+{
+    assert(at < size());
+    return *(begin() + at);
+}
+
 inline uint32_t watch_subarray_const::size() const
 {
     return base_at->size;
@@ -523,7 +596,7 @@ inline bool watch_subarray_const::empty() const
 }
 inline const Watched* watch_subarray_const::begin() const
 {
-    return base->mems[base_at->num].base_ptr + base_at->offset;
+    return base_at->ptr;
 }
 
 inline const Watched* watch_subarray_const::end() const
@@ -548,4 +621,4 @@ inline void swap(watch_subarray a, watch_subarray b)
 
 } //End of namespace
 
-#endif //__WATCHARRAY_H__
+#endif //__WATCHARRAY_HANDROLLED_H__
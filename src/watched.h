@@ -48,6 +48,14 @@ This class contains two 32-bit datapieces. They are either used as:
 \li Two literals, in the case of tertiary clauses
 \li One blocking literal (i.e. an example literal from the clause) and a clause
 offset (as per ClauseAllocator ), in the case of long clauses
+
+Literals and clause abstractions take at most 30 bits, so the top 2 bits of
+data1 hold the top 2 bits of the clause offset, and data2 the rest. This way
+all 32 bits of ClOffset can be used while the watch stays 8 bytes.
+
+When built with WATCH_CACHED_LITS, watches of long clauses also carry two more
+literals of the clause. If either is true, the clause is satisfied and need
+not be dereferenced. For 4-long clauses these are all the other literals.
 */
 class Watched {
     public:
@@ -55,20 +63,30 @@ class Watched {
         @brief Constructor for a long (>3) clause
         */
         Watched(const ClOffset offset, Lit blockedLit) :
-            data1(blockedLit.toInt())
+            data1(blockedLit.toInt() | (offset & offset_high_mask))
             , type(watch_clause_t)
-            , data2(offset)
+            , data2(offset & offset_low_mask)
         {
+            #ifdef DEBUG_WATCHED
+            assert((blockedLit.toInt() & offset_high_mask) == 0);
+            #endif
+            #ifdef WATCH_CACHED_LITS
+            cached[0] = blockedLit.toInt();
+            cached[1] = blockedLit.toInt();
+            #endif
         }
 
         /**
         @brief Constructor for a long (>3) clause
         */
         Watched(const ClOffset offset, cl_abst_type abst) :
-            data1(abst)
+            data1(abst | (offset & offset_high_mask))
             , type(watch_clause_t)
-            , data2(offset)
+            , data2(offset & offset_low_mask)
         {
+            #ifdef DEBUG_WATCHED
+            assert((abst & offset_high_mask) == 0);
+            #endif
         }
 
         Watched() :
@@ -111,7 +129,8 @@ class Watched {
             #ifdef DEBUG_WATCHED
             assert(type == watch_clause_t);
             #endif
-            data2 = offset;
+            data1 = (data1 & offset_low_mask) | (offset & offset_high_mask);
+            data2 = offset & offset_low_mask;
         }
 
         /**
@@ -122,7 +141,7 @@ class Watched {
             #ifdef DEBUG_WATCHED
             assert(type == watch_clause_t);
             #endif
-            data1 = blockedLit.toInt();
+            data1 = blockedLit.toInt() | (data1 & offset_high_mask);
         }
 
         WatchType getType() const
@@ -250,15 +269,37 @@ class Watched {
             #ifdef DEBUG_WATCHED
             assert(isClause());
             #endif
-            return Lit::toLit(data1);
+            return Lit::toLit(data1 & offset_low_mask);
+        }
+
+        #ifdef WATCH_CACHED_LITS
+        /**
+        @brief Set the two cached literals of a >3-long normal clause
+        */
+        void setCachedLits(const Lit lit1, const Lit lit2)
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            cached[0] = lit1.toInt();
+            cached[1] = lit2.toInt();
+        }
+
+        Lit getCachedLit(const size_t at) const
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            return Lit::toLit(cached[at]);
         }
+        #endif
 
         cl_abst_type getAbst() const
         {
             #ifdef DEBUG_WATCHED
             assert(isClause());
             #endif
-            return data1;
+            return data1 & offset_low_mask;
         }
 
         /**
@@ -269,7 +310,7 @@ class Watched {
             #ifdef DEBUG_WATCHED
             assert(isClause());
             #endif
-            return data2;
+            return data2 | (data1 & offset_high_mask);
         }
 
         bool operator==(const Watched& other) const
@@ -336,12 +377,19 @@ class Watched {
         }
 
     private:
+        static const uint32_t offset_low_mask = (1U << 30) - 1;
+        static const uint32_t offset_high_mask = ~offset_low_mask;
+
         uint32_t data1;
         // binary, tertiary or long, as per WatchType
         // currently WatchType is enum with range [0..3] and fits in type
         // in case if WatchType extended type size won't be enough.
         uint32_t type:2;
         uint32_t data2:30;
+        #ifdef WATCH_CACHED_LITS
+        //Only meaningful for long clauses, always literals of the clause
+        uint32_t cached[2] = {0, 0};
+        #endif
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Watched& ws)
@@ -88,6 +88,182 @@ BOOST_AUTO_TEST_CASE(solve_multi_thread)
     BOOST_CHECK_EQUAL(s.get_model()[1], l_True);
 }
 
+static vector<vector<Lit> > add_random_clauses(
+    SATSolver& s
+    , const unsigned num_vars
+    , const size_t num_cls
+    , const size_t cl_size
+    , uint32_t seed
+) {
+    vector<vector<Lit> > cls;
+    for(size_t i = 0; i < num_cls; i++) {
+        vector<Lit> cl;
+        for(size_t j = 0; j < cl_size; j++) {
+            seed = seed*1103515245U + 12345U;
+            cl.push_back(Lit((seed >> 8) % num_vars, (seed >> 20) & 1));
+        }
+        s.add_clause(cl);
+        cls.push_back(cl);
+    }
+    return cls;
+}
+
+static void check_model(const SATSolver& s, const vector<vector<Lit> >& cls)
+{
+    for(const vector<Lit>& cl: cls) {
+        bool sat = false;
+        for(const Lit lit: cl) {
+            sat |= (s.get_model()[lit.var()] ^ lit.sign()) == l_True;
+        }
+        BOOST_CHECK( sat);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(solve_multi_thread_cloned_clauses)
+{
+    SATSolver s;
+    s.set_num_threads(3);
+    s.new_vars(6);
+    vector<vector<Lit> > cls = {
+        {Lit(0, false), Lit(1, false)}
+        , {Lit(0, true), Lit(2, false), Lit(3, false)}
+        , {Lit(1, true), Lit(2, true), Lit(4, false), Lit(5, false)}
+        , {Lit(5, true)}
+        , {Lit(4, true), Lit(0, false), Lit(0, false)}
+        , {Lit(3, true), Lit(3, false), Lit(2, false)}
+    };
+    for(const vector<Lit>& cl: cls) {
+        BOOST_CHECK( s.add_clause(cl));
+    }
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+    BOOST_CHECK_EQUAL( s.get_model()[5], l_False);
+}
+
+BOOST_AUTO_TEST_CASE(solve_multi_thread_shared_arena)
+{
+    SolverConf conf;
+    conf.share_irred_arena = true;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    s.new_vars(200);
+
+    vector<vector<Lit> > cls = add_random_clauses(s, 200, 600, 5, 3);
+    cls.push_back(vector<Lit>{Lit(7, true)});
+    s.add_clause(cls.back());
+
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+}
+
+BOOST_AUTO_TEST_CASE(solve_multi_thread_pinned)
+{
+    //1 = fill up NUMA nodes one by one, 2 = spread threads over them
+    for(int pinning = 1; pinning <= 2; pinning++) {
+        SolverConf conf;
+        conf.thread_pinning = pinning;
+        SATSolver s(&conf);
+        s.set_num_threads(3);
+        s.new_vars(200);
+
+        const vector<vector<Lit> > cls = add_random_clauses(s, 200, 600, 5, 4);
+        lbool ret = s.solve();
+        BOOST_CHECK_EQUAL( ret, l_True);
+        check_model(s, cls);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(renumber_long_clauses)
+{
+    SolverConf conf;
+    conf.simplify_at_startup = true;
+    conf.simplify_at_every_startup = true;
+    conf.full_simplify_at_startup = true;
+    SATSolver s(&conf);
+    s.new_vars(200);
+
+    //Units make renumbering move the variables of the long clauses
+    vector<vector<Lit> > cls;
+    for(unsigned v = 0; v < 200; v += 10) {
+        cls.push_back(vector<Lit>{Lit(v, (v / 10) % 2)});
+        s.add_clause(cls.back());
+    }
+    vector<vector<Lit> > more = add_random_clauses(s, 200, 1000, 4, 1);
+    cls.insert(cls.end(), more.begin(), more.end());
+
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+
+    more = add_random_clauses(s, 200, 200, 4, 2);
+    cls.insert(cls.end(), more.begin(), more.end());
+    ret = s.solve();
+    BOOST_CHECK( ret != l_Undef);
+    if (ret == l_True) {
+        check_model(s, cls);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(clause_larger_than_slab)
+{
+    //A slab of the clause allocator holds 16MB, this clause needs more
+    const unsigned num_vars = 4500000;
+    SATSolver s;
+    s.new_vars(num_vars);
+
+    vector<Lit> big;
+    for(unsigned v = 0; v < num_vars; v++) {
+        big.push_back(Lit(v, v % 2));
+    }
+    s.add_clause(big);
+    vector<vector<Lit> > cls = add_random_clauses(s, 100, 300, 3, 3);
+    cls.push_back(big);
+
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+}
+
+BOOST_AUTO_TEST_CASE(chrono_backtrack)
+{
+    SolverConf conf;
+    conf.chrono_backtrack = 0;
+    SATSolver s(&conf);
+    s.new_vars(200);
+
+    vector<vector<Lit> > cls = add_random_clauses(s, 200, 800, 3, 13);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+
+    //Flip the model's first two values
+    vector<Lit> assumps;
+    assumps.push_back(Lit(0, s.get_model()[0] == l_True));
+    assumps.push_back(Lit(1, s.get_model()[1] == l_True));
+    ret = s.solve(&assumps);
+    BOOST_CHECK_EQUAL( ret, l_True);
+    check_model(s, cls);
+    BOOST_CHECK_EQUAL( s.get_model()[0] ^ assumps[0].sign(), l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[1] ^ assumps[1].sign(), l_True);
+
+    const vector<vector<Lit> > more = add_random_clauses(s, 200, 40, 3, 14);
+    cls.insert(cls.end(), more.begin(), more.end());
+    ret = s.solve();
+    BOOST_CHECK( ret != l_Undef);
+    if (ret == l_True) {
+        check_model(s, cls);
+    }
+
+    SATSolver s2(&conf);
+    s2.new_vars(120);
+    add_random_clauses(s2, 120, 560, 3, 15);
+    BOOST_CHECK_EQUAL( s2.solve(), l_False);
+    BOOST_CHECK( s.get_num_chrono_backtracks() > 0);
+    BOOST_CHECK( s2.get_num_chrono_backtracks() > 0);
+}
+
 BOOST_AUTO_TEST_CASE(logfile)
 {
     SATSolver* s = new SATSolver();
@@ -167,6 +343,91 @@ BOOST_AUTO_TEST_CASE(logfile2_assumps)
     BOOST_CHECK_EQUAL(line, "c Solver::solve( -2 )");
 }
 
+static vector<lbool> solve_random_deterministic(lbool& ret, unsigned long& rounds)
+{
+    //Threads sync at restarts, so short and frequent restarts make sure they
+    //go through many rounds of exchanging clauses
+    SolverConf conf;
+    conf.deterministic_sync = true;
+    conf.sync_every_props = 200;
+    conf.restartType = Restart::geom;
+    conf.restart_first = 20;
+    conf.restart_inc = 1;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    s.new_vars(200);
+    add_random_clauses(s, 200, 840, 3, 1);
+    ret = s.solve();
+    rounds = s.get_num_sync_rounds();
+    if (ret == l_True) {
+        return s.get_model();
+    }
+    return vector<lbool>();
+}
+
+BOOST_AUTO_TEST_CASE(deterministic_multi_thread)
+{
+    lbool ret1;
+    lbool ret2;
+    unsigned long rounds1;
+    unsigned long rounds2;
+    const vector<lbool> model1 = solve_random_deterministic(ret1, rounds1);
+    const vector<lbool> model2 = solve_random_deterministic(ret2, rounds2);
+    BOOST_CHECK( ret1 != l_Undef);
+    BOOST_CHECK( rounds1 > 10);
+    BOOST_CHECK_EQUAL( rounds1, rounds2);
+    BOOST_CHECK_EQUAL( ret1, ret2);
+    BOOST_CHECK( model1 == model2);
+}
+
+static vector<lbool> solve_random_bins(const bool simd, lbool& ret)
+{
+    SolverConf conf;
+    conf.doSIMDBinProp = simd;
+    SATSolver s(&conf);
+    s.new_vars(300);
+    add_random_clauses(s, 300, 300, 2, 5);
+    add_random_clauses(s, 300, 900, 3, 6);
+    ret = s.solve();
+    if (ret == l_True) {
+        return s.get_model();
+    }
+    return vector<lbool>();
+}
+
+BOOST_AUTO_TEST_CASE(simd_bin_prop_same_as_scalar)
+{
+    lbool ret1;
+    lbool ret2;
+    const vector<lbool> model1 = solve_random_bins(true, ret1);
+    const vector<lbool> model2 = solve_random_bins(false, ret2);
+    BOOST_CHECK( ret1 != l_Undef);
+    BOOST_CHECK_EQUAL( ret1, ret2);
+    BOOST_CHECK( model1 == model2);
+}
+
+BOOST_AUTO_TEST_CASE(cube_and_conquer)
+{
+    SolverConf conf;
+    conf.do_cube_and_conquer = true;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    s.new_vars(100);
+    const vector<vector<Lit> > cls = add_random_clauses(s, 100, 380, 3, 7);
+
+    lbool ret = s.solve();
+    BOOST_CHECK( ret != l_Undef);
+    if (ret == l_True) {
+        check_model(s, cls);
+    }
+
+    vector<Lit> unit;
+    unit.push_back(Lit(0, false));
+    s.add_clause(unit);
+    unit[0] = Lit(0, true);
+    s.add_clause(unit);
+    BOOST_CHECK_EQUAL( s.solve(), l_False);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -592,6 +853,138 @@ BOOST_AUTO_TEST_CASE(abort_early)
     BOOST_CHECK_EQUAL( ret, l_Undef);
 }
 
+static void add_pigeonhole(SATSolver& s, const unsigned holes)
+{
+    s.new_vars((holes+1)*holes);
+    for(unsigned p = 0; p <= holes; p++) {
+        vector<Lit> cl;
+        for(unsigned h = 0; h < holes; h++) {
+            cl.push_back(Lit(p*holes+h, false));
+        }
+        s.add_clause(cl);
+    }
+    for(unsigned h = 0; h < holes; h++) {
+        for(unsigned p = 0; p <= holes; p++) {
+            for(unsigned p2 = p+1; p2 <= holes; p2++) {
+                s.add_clause(vector<Lit>{Lit(p*holes+h, true), Lit(p2*holes+h, true)});
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(terminate_callback)
+{
+    SATSolver s;
+    s.set_no_simplify_at_startup();
+
+    //too hard to finish within one poll interval
+    add_pigeonhole(s, 9);
+
+    unsigned called = 0;
+    s.set_terminate_callback([](void* state) -> int {
+        (*(unsigned*)state)++;
+        return 1;
+    }, &called);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_Undef);
+    BOOST_CHECK_EQUAL( called, 1U);
+
+    s.set_terminate_callback(NULL, NULL);
+    s.set_max_confl(1000);
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( called, 1U);
+}
+
+BOOST_AUTO_TEST_CASE(terminate_callback_cube)
+{
+    SolverConf conf;
+    conf.do_cube_and_conquer = true;
+    SATSolver s(&conf);
+    s.set_num_threads(3);
+    add_pigeonhole(s, 9);
+
+    //Any thread may poll, but only until one of them asks to stop
+    unsigned called = 0;
+    s.set_terminate_callback([](void* state) -> int {
+        (*(unsigned*)state)++;
+        return 1;
+    }, &called);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_Undef);
+    BOOST_CHECK_EQUAL( called, 1U);
+}
+
+struct LearntStore
+{
+    vector<vector<Lit> > cls;
+    vector<unsigned> glues;
+};
+
+BOOST_AUTO_TEST_CASE(learnt_callback)
+{
+    LearntStore store;
+    SATSolver s;
+    s.set_no_simplify_at_startup();
+    s.set_learnt_callback(8, 6, [](void* state, const vector<Lit>& lits, unsigned glue) {
+        LearntStore* st = (LearntStore*)state;
+        st->cls.push_back(lits);
+        st->glues.push_back(glue);
+    }, &store);
+    add_pigeonhole(s, 6);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+    BOOST_REQUIRE( !store.cls.empty() );
+    for(size_t i = 0; i < store.cls.size(); i++) {
+        BOOST_CHECK( store.cls[i].size() <= 8 );
+        BOOST_CHECK( store.glues[i] <= 6 );
+        for(Lit lit: store.cls[i]) {
+            BOOST_CHECK( lit.var() < 7*6 );
+        }
+    }
+
+    //Importing implied clauses must not change the result
+    SATSolver s2;
+    s2.set_no_simplify_at_startup();
+    add_pigeonhole(s2, 6);
+    for(size_t i = 0; i < store.cls.size(); i++) {
+        s2.add_learnt_clause(store.cls[i], store.glues[i]);
+    }
+    ret = s2.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+
+    SATSolver s3;
+    add_pigeonhole(s3, 4);
+    BOOST_CHECK( s3.add_learnt_clause(vector<Lit>{Lit(0, true), Lit(1, true)}, 2) );
+    ret = s3.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+}
+
+BOOST_AUTO_TEST_CASE(add_clauses_batch)
+{
+    for(unsigned threads = 1; threads <= 2; threads++) {
+        SATSolver s;
+        s.set_num_threads(threads);
+        s.new_vars(3);
+        const vector<Lit> buf = {
+            Lit(0, false), Lit(1, false), lit_Undef
+            , Lit(0, true), lit_Undef
+            , Lit(1, true), Lit(2, false), Lit(2, true), lit_Undef
+            , Lit(2, true)
+        };
+        s.add_clauses(buf.data(), buf.size());
+        lbool ret = s.solve();
+        BOOST_CHECK_EQUAL( ret, l_True);
+        BOOST_CHECK_EQUAL( s.get_model()[0], l_False);
+        BOOST_CHECK_EQUAL( s.get_model()[1], l_True);
+        BOOST_CHECK_EQUAL( s.get_model()[2], l_False);
+
+        const vector<Lit> buf2 = {Lit(1, true), lit_Undef};
+        s.add_clauses(buf2.data(), buf2.size());
+        ret = s.solve();
+        BOOST_CHECK_EQUAL( ret, l_False);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(xor3)
 {
     SolverConf conf;
@@ -24,6 +24,8 @@ THE SOFTWARE.
 #include <boost/test/unit_test.hpp>
 
 #include "src/clause.h"
+#include "src/watched.h"
+#include "src/propby.h"
 #include <sstream>
 #include <stdlib.h>
 
@@ -74,4 +76,26 @@ BOOST_AUTO_TEST_CASE(convert_to_string2)
     BOOST_CHECK_EQUAL( ss.str(), "1 -2 3");
 }
 
+BOOST_AUTO_TEST_CASE(full_offset_in_watch_and_propby)
+{
+    const ClOffset offset = 0xC0000005U;
+    const Lit blocked = Lit((1U << 28) - 1, true);
+    Watched w(offset, blocked);
+    BOOST_CHECK_EQUAL( w.get_offset(), offset);
+    BOOST_CHECK_EQUAL( w.getBlockedLit(), blocked);
+
+    w.setBlockedLit(Lit(3, false));
+    BOOST_CHECK_EQUAL( w.get_offset(), offset);
+    w.setNormOffset(0x40000007U);
+    BOOST_CHECK_EQUAL( w.get_offset(), 0x40000007U);
+    BOOST_CHECK_EQUAL( w.getBlockedLit(), Lit(3, false));
+
+    const cl_abst_type abst = calcAbstraction(vector<Lit>(60, blocked));
+    Watched occ(offset, abst);
+    BOOST_CHECK_EQUAL( occ.get_offset(), offset);
+    BOOST_CHECK_EQUAL( occ.getAbst(), abst);
+
+    BOOST_CHECK_EQUAL( PropBy(offset).get_offset(), offset);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file